@@ -29,6 +29,17 @@
 
 //..............................................................................
 
+// the runtime jumps to SJLJ frames with _longjmp on POSIX (signal masks are
+// not saved or restored), so host frames are set up with the matching _setjmp
+
+#if (_JNC_OS_POSIX)
+#	define JNC_SETJMP _setjmp
+#else
+#	define JNC_SETJMP setjmp
+#endif
+
+//..............................................................................
+
 #define JNC_BEGIN_CALL_SITE_IMPL(runtime) \
 	jnc_Runtime* __jncRuntime = (runtime); \
 	jnc_CallSite __jncCallSite; \
@@ -38,7 +49,7 @@
 	JNC_ASSERT (runtime); \
 	jnc_Runtime_initializeCallSite (__jncRuntime, &__jncCallSite); \
 	__jncSjljPrevFrame = jnc_Runtime_setSjljFrame (__jncRuntime, &__jncSjljFrame); \
-	__jncSjljBranch = setjmp (__jncSjljFrame.m_jmpBuf); \
+	__jncSjljBranch = JNC_SETJMP (__jncSjljFrame.m_jmpBuf); \
 	if (!__jncSjljBranch) \
 	{
 
@@ -83,6 +94,46 @@
 	*(result) = __jncCallSite.m_result != 0; \
 	}
 
+//. . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+// a host thread calling into the same runtime over and over again (e.g. a
+// handler per received packet) can enter the runtime once with
+// jnc_Runtime_enterCallSite and then make entered calls, which skip TLS and
+// GC mutator setup; between calls the thread is parked in a GC wait region.
+// exceptions are still caught per call. the call site must be left with
+// jnc_Runtime_leaveCallSite on the same thread
+
+#define JNC_BEGIN_ENTERED_CALL_SITE(runtime, callSite) \
+	{ \
+	jnc_Runtime* __jncRuntime = (runtime); \
+	jnc_CallSite* __jncEnteredCallSite = (callSite); \
+	jnc_SjljFrame __jncSjljFrame; \
+	jnc_SjljFrame* __jncSjljPrevFrame; \
+	int __jncSjljBranch; \
+	JNC_ASSERT (__jncRuntime && __jncEnteredCallSite); \
+	__jncSjljPrevFrame = jnc_Runtime_setSjljFrame (__jncRuntime, &__jncSjljFrame); \
+	__jncSjljBranch = JNC_SETJMP (__jncSjljFrame.m_jmpBuf); \
+	if (!__jncSjljBranch) \
+	{ \
+		jnc_Runtime_beginEnteredCall (__jncRuntime, __jncEnteredCallSite);
+
+#define JNC_END_ENTERED_CALL_SITE_IMPL() \
+	} \
+	{ \
+		jnc_SjljFrame* prev = jnc_Runtime_setSjljFrame (__jncRuntime, __jncSjljPrevFrame); \
+		JNC_ASSERT (prev == &__jncSjljFrame || prev == __jncSjljPrevFrame); \
+	} \
+	jnc_Runtime_endEnteredCall (__jncRuntime, __jncEnteredCallSite, __jncSjljBranch == 0);
+
+#define JNC_END_ENTERED_CALL_SITE() \
+	JNC_END_ENTERED_CALL_SITE_IMPL () \
+	}
+
+#define JNC_END_ENTERED_CALL_SITE_EX(result) \
+	JNC_END_ENTERED_CALL_SITE_IMPL () \
+	*(result) = __jncSjljBranch == 0; \
+	}
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 #ifdef __cplusplus
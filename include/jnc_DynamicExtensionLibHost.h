@@ -1193,6 +1193,35 @@ jnc_Runtime_SetSjljFrameFunc (
 	jnc_SjljFrame* frame
 	);
 
+typedef
+void
+jnc_Runtime_EnterCallSiteFunc (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	);
+
+typedef
+void
+jnc_Runtime_LeaveCallSiteFunc (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	);
+
+typedef
+void
+jnc_Runtime_BeginEnteredCallFunc (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	);
+
+typedef
+void
+jnc_Runtime_EndEnteredCallFunc (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite,
+	bool_t result
+	);
+
 typedef
 void*
 jnc_Runtime_GetUserDataFunc (jnc_Runtime* runtime);
@@ -1275,6 +1304,10 @@ struct jnc_RuntimeFuncTable
 	jnc_StrLenFunc* m_strLenFunc;
 	jnc_StrDupFunc* m_strDupFunc;
 	jnc_MemDupFunc* m_memDupFunc;
+	jnc_Runtime_EnterCallSiteFunc* m_enterCallSiteFunc;
+	jnc_Runtime_LeaveCallSiteFunc* m_leaveCallSiteFunc;
+	jnc_Runtime_BeginEnteredCallFunc* m_beginEnteredCallFunc;
+	jnc_Runtime_EndEnteredCallFunc* m_endEnteredCallFunc;
 };
 
 //..............................................................................
@@ -72,6 +72,9 @@ enum jnc_ModuleCompileFlag
 	jnc_ModuleCompileFlag_DisableDoxyComment4                  = 0x00010000,
 	jnc_ModuleCompileFlag_SimpleCheckDivByZero                 = 0x00100000,
 	jnc_ModuleCompileFlag_SimpleCheckNullPtr                   = 0x00200000,
+	jnc_ModuleCompileFlag_Optimize                             = 0x00400000,
+	jnc_ModuleCompileFlag_HostCpu                              = 0x00800000,
+	jnc_ModuleCompileFlag_StripUnusedLibFunctions              = 0x01000000,
 
 	jnc_ModuleCompileFlag_StdFlags =
 		jnc_ModuleCompileFlag_GcSafePointInPrologue |
@@ -99,6 +102,58 @@ typedef enum jnc_ModuleCompileState jnc_ModuleCompileState;
 
 //..............................................................................
 
+enum jnc_ModuleCompilePhase
+{
+	jnc_ModuleCompilePhase_Parse,
+	jnc_ModuleCompilePhase_Link,
+	jnc_ModuleCompilePhase_CalcLayout,
+	jnc_ModuleCompilePhase_CompileFunctions,
+	jnc_ModuleCompilePhase_InjectTlsPrologues,
+	jnc_ModuleCompilePhase_DeleteUnreachableBlocks,
+	jnc_ModuleCompilePhase_Optimize,
+	jnc_ModuleCompilePhase_Jit,
+	jnc_ModuleCompilePhase__Count,
+};
+
+typedef enum jnc_ModuleCompilePhase jnc_ModuleCompilePhase;
+
+// . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+// all times are expressed in 100-nanosecond intervals
+
+struct jnc_ModuleCompilePhaseTime
+{
+	uint64_t m_wallTime;
+	uint64_t m_cpuTime;
+};
+
+typedef struct jnc_ModuleCompilePhaseTime jnc_ModuleCompilePhaseTime;
+
+// . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+struct jnc_ModuleCompileStats
+{
+	jnc_ModuleCompilePhaseTime m_phaseTimeTable [jnc_ModuleCompilePhase__Count];
+	size_t m_tokenCount;
+	size_t m_functionCount;
+	size_t m_typeCount;
+	size_t m_llvmInstructionCount;
+	size_t m_machineCodeSize;
+	size_t m_widenedRangeCheckCount;
+	size_t m_optimizedFunctionCount;
+	size_t m_strippedFunctionCount;
+};
+
+typedef struct jnc_ModuleCompileStats jnc_ModuleCompileStats;
+
+//..............................................................................
+
+JNC_EXTERN_C
+const char*
+jnc_getModuleCompilePhaseString (jnc_ModuleCompilePhase phase);
+
+//..............................................................................
+
 JNC_EXTERN_C
 jnc_Module*
 jnc_Module_create ();
@@ -119,6 +174,14 @@ jnc_Module_initialize (
 	uint_t compileFlags
 	);
 
+JNC_EXTERN_C
+void
+jnc_Module_setJitCpu (
+	jnc_Module* module,
+	const char* cpu,
+	const char* features // comma-separated, e.g. "+avx2,+bmi2,-sse4a"
+	);
+
 JNC_EXTERN_C
 uint_t
 jnc_Module_getCompileFlags (jnc_Module* module);
@@ -127,6 +190,13 @@ JNC_EXTERN_C
 jnc_ModuleCompileState
 jnc_Module_getCompileState (jnc_Module* module);
 
+JNC_EXTERN_C
+void
+jnc_Module_getCompileStats (
+	jnc_Module* module,
+	jnc_ModuleCompileStats* stats
+	);
+
 JNC_EXTERN_C
 jnc_GlobalNamespace*
 jnc_Module_getGlobalNamespace (jnc_Module* module);
@@ -237,6 +307,13 @@ JNC_EXTERN_C
 bool_t
 jnc_Module_parseImports (jnc_Module* module);
 
+JNC_EXTERN_C
+bool_t
+jnc_Module_isFileModified (
+	jnc_Module* module,
+	const char* fileName
+	);
+
 JNC_EXTERN_C
 bool_t
 jnc_Module_link (jnc_Module* module);
@@ -253,6 +330,13 @@ JNC_EXTERN_C
 bool_t
 jnc_Module_jit (jnc_Module* module);
 
+// releases compiler data not needed to run a jitted module;
+// returns an estimate of the number of bytes reclaimed
+
+JNC_EXTERN_C
+size_t
+jnc_Module_finalizeForRuntime (jnc_Module* module);
+
 JNC_EXTERN_C
 bool_t
 jnc_Module_generateDocumentation (
@@ -297,6 +381,15 @@ struct jnc_Module
 		jnc_Module_initialize (this, tag, compileFlags);
 	}
 
+	void
+	setJitCpu (
+		const char* cpu,
+		const char* features = NULL
+		)
+	{
+		jnc_Module_setJitCpu (this, cpu, features);
+	}
+
 	uint_t
 	getCompileFlags ()
 	{
@@ -309,6 +402,12 @@ struct jnc_Module
 		return jnc_Module_getCompileState (this);
 	}
 
+	void
+	getCompileStats (jnc_ModuleCompileStats* stats)
+	{
+		jnc_Module_getCompileStats (this, stats);
+	}
+
 	jnc_GlobalNamespace*
 	getGlobalNamespace ()
 	{
@@ -432,6 +531,12 @@ struct jnc_Module
 		return jnc_Module_parseImports (this) != 0;
 	}
 
+	bool
+	isFileModified (const char* fileName)
+	{
+		return jnc_Module_isFileModified (this, fileName) != 0;
+	}
+
 	bool
 	link ()
 	{
@@ -456,6 +561,12 @@ struct jnc_Module
 		return jnc_Module_jit (this) != 0;
 	}
 
+	size_t
+	finalizeForRuntime ()
+	{
+		return jnc_Module_finalizeForRuntime (this);
+	}
+
 	const char*
 	getLlvmIrString_v ()
 	{
@@ -489,6 +600,31 @@ const ModuleCompileState
 
 //..............................................................................
 
+typedef jnc_ModuleCompilePhase ModuleCompilePhase;
+
+const ModuleCompilePhase
+	ModuleCompilePhase_Parse                   = jnc_ModuleCompilePhase_Parse,
+	ModuleCompilePhase_Link                    = jnc_ModuleCompilePhase_Link,
+	ModuleCompilePhase_CalcLayout              = jnc_ModuleCompilePhase_CalcLayout,
+	ModuleCompilePhase_CompileFunctions        = jnc_ModuleCompilePhase_CompileFunctions,
+	ModuleCompilePhase_InjectTlsPrologues      = jnc_ModuleCompilePhase_InjectTlsPrologues,
+	ModuleCompilePhase_DeleteUnreachableBlocks = jnc_ModuleCompilePhase_DeleteUnreachableBlocks,
+	ModuleCompilePhase_Optimize                = jnc_ModuleCompilePhase_Optimize,
+	ModuleCompilePhase_Jit                     = jnc_ModuleCompilePhase_Jit,
+	ModuleCompilePhase__Count                  = jnc_ModuleCompilePhase__Count;
+
+typedef jnc_ModuleCompilePhaseTime ModuleCompilePhaseTime;
+typedef jnc_ModuleCompileStats ModuleCompileStats;
+
+inline
+const char*
+getModuleCompilePhaseString (ModuleCompilePhase phase)
+{
+	return jnc_getModuleCompilePhaseString (phase);
+}
+
+//..............................................................................
+
 typedef jnc_ModuleCompileFlag ModuleCompileFlag;
 
 const ModuleCompileFlag
@@ -509,6 +645,9 @@ const ModuleCompileFlag
 	ModuleCompileFlag_DisableDoxyComment4                  = jnc_ModuleCompileFlag_DisableDoxyComment4,
 	ModuleCompileFlag_SimpleCheckDivByZero                 = jnc_ModuleCompileFlag_SimpleCheckDivByZero,
 	ModuleCompileFlag_SimpleCheckNullPtr                   = jnc_ModuleCompileFlag_SimpleCheckNullPtr,
+	ModuleCompileFlag_Optimize                             = jnc_ModuleCompileFlag_Optimize,
+	ModuleCompileFlag_HostCpu                              = jnc_ModuleCompileFlag_HostCpu,
+	ModuleCompileFlag_StripUnusedLibFunctions              = jnc_ModuleCompileFlag_StripUnusedLibFunctions,
 	ModuleCompileFlag_StdFlags                             = jnc_ModuleCompileFlag_StdFlags;
 
 //..............................................................................
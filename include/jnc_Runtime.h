@@ -124,6 +124,35 @@ jnc_Runtime_setSjljFrame (
 	jnc_SjljFrame* frame
 	);
 
+JNC_EXTERN_C
+void
+jnc_Runtime_enterCallSite (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	);
+
+JNC_EXTERN_C
+void
+jnc_Runtime_leaveCallSite (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	);
+
+JNC_EXTERN_C
+void
+jnc_Runtime_beginEnteredCall (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	);
+
+JNC_EXTERN_C
+void
+jnc_Runtime_endEnteredCall (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite,
+	bool_t result
+	);
+
 JNC_EXTERN_C
 void*
 jnc_Runtime_getUserData (jnc_Runtime* runtime);
@@ -217,6 +246,18 @@ struct jnc_Runtime
 		jnc_Runtime_uninitializeCallSite (this, callSite);
 	}
 
+	void
+	enterCallSite (jnc_CallSite* callSite)
+	{
+		jnc_Runtime_enterCallSite (this, callSite);
+	}
+
+	void
+	leaveCallSite (jnc_CallSite* callSite)
+	{
+		jnc_Runtime_leaveCallSite (this, callSite);
+	}
+
 	void*
 	getUserData ()
 	{
@@ -308,6 +308,7 @@ struct jnc_TlsVariableTable
 {
 	jnc_SjljFrame* m_sjljFrame;
 	jnc_GcShadowStackFrame* m_gcShadowStackTop;
+	void* m_stackLimit; // prologues compare the frame address against it
 
 	// followed by user-defined TLS variables
 };
@@ -342,6 +342,10 @@ static jnc_RuntimeFuncTable g_runtimeFuncTable =
 	jnc_strLen,
 	jnc_strDup,
 	jnc_memDup,
+	jnc_Runtime_enterCallSite,
+	jnc_Runtime_leaveCallSite,
+	jnc_Runtime_beginEnteredCall,
+	jnc_Runtime_endEnteredCall,
 };
 
 static jnc_GcHeapFuncTable g_gcHeapFuncTable =
@@ -119,6 +119,28 @@ jnc_Module_addOpaqueClassTypeInfo (
 
 #else // _JNC_DYNAMIC_EXTENSION_LIB
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+const char*
+jnc_getModuleCompilePhaseString (jnc_ModuleCompilePhase phase)
+{
+	static const char* stringTable [jnc_ModuleCompilePhase__Count] =
+	{
+		"parse",                     // jnc_ModuleCompilePhase_Parse,
+		"link",                      // jnc_ModuleCompilePhase_Link,
+		"calc-layout",               // jnc_ModuleCompilePhase_CalcLayout,
+		"compile-functions",         // jnc_ModuleCompilePhase_CompileFunctions,
+		"inject-tls-prologues",      // jnc_ModuleCompilePhase_InjectTlsPrologues,
+		"delete-unreachable-blocks", // jnc_ModuleCompilePhase_DeleteUnreachableBlocks,
+		"optimize",                  // jnc_ModuleCompilePhase_Optimize,
+		"jit",                       // jnc_ModuleCompilePhase_Jit,
+	};
+
+	return (size_t) phase < jnc_ModuleCompilePhase__Count ?
+		stringTable [phase] :
+		"undefined-compile-phase";
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 jnc_Module*
@@ -155,6 +177,18 @@ jnc_Module_initialize (
 	module->initialize (tag, compileFlags);
 }
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Module_setJitCpu (
+	jnc_Module* module,
+	const char* cpu,
+	const char* features
+	)
+{
+	module->setJitCpu (cpu, features);
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 uint_t
@@ -171,6 +205,17 @@ jnc_Module_getCompileState (jnc_Module* module)
 	return module->getCompileState ();
 }
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Module_getCompileStats (
+	jnc_Module* module,
+	jnc_ModuleCompileStats* stats
+	)
+{
+	*stats = module->getCompileStats ();
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 jnc_GlobalNamespace*
@@ -341,6 +386,17 @@ jnc_Module_parseImports (jnc_Module* module)
 	return module->parseImports ();
 }
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+bool_t
+jnc_Module_isFileModified (
+	jnc_Module* module,
+	const char* fileName
+	)
+{
+	return module->isFileModified (fileName);
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 bool_t
@@ -373,6 +429,14 @@ jnc_Module_jit (jnc_Module* module)
 	return module->jit ();
 }
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+size_t
+jnc_Module_finalizeForRuntime (jnc_Module* module)
+{
+	return module->finalizeForRuntime ();
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 const char*
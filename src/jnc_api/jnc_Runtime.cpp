@@ -144,6 +144,51 @@ jnc_Runtime_setSjljFrame (
 	return jnc_g_dynamicExtensionLibHost->m_runtimeFuncTable->m_setSjljFrameFunc (runtime, frame);
 }
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_enterCallSite (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	)
+{
+	jnc_g_dynamicExtensionLibHost->m_runtimeFuncTable->m_enterCallSiteFunc (runtime, callSite);
+}
+
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_leaveCallSite (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	)
+{
+	jnc_g_dynamicExtensionLibHost->m_runtimeFuncTable->m_leaveCallSiteFunc (runtime, callSite);
+}
+
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_beginEnteredCall (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	)
+{
+	jnc_g_dynamicExtensionLibHost->m_runtimeFuncTable->m_beginEnteredCallFunc (runtime, callSite);
+}
+
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_endEnteredCall (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite,
+	bool_t result
+	)
+{
+	jnc_g_dynamicExtensionLibHost->m_runtimeFuncTable->m_endEnteredCallFunc (runtime, callSite, result);
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 void*
@@ -359,6 +404,51 @@ jnc_Runtime_setSjljFrame (
 	return runtime->setSjljFrame (frame);
 }
 
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_enterCallSite (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	)
+{
+	runtime->enterCallSite (callSite);
+}
+
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_leaveCallSite (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	)
+{
+	runtime->leaveCallSite (callSite);
+}
+
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_beginEnteredCall (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite
+	)
+{
+	runtime->beginEnteredCall (callSite);
+}
+
+JNC_EXTERN_C
+JNC_EXPORT_O
+void
+jnc_Runtime_endEnteredCall (
+	jnc_Runtime* runtime,
+	jnc_CallSite* callSite,
+	bool_t result
+	)
+{
+	runtime->endEnteredCall (callSite, result != 0);
+}
+
 JNC_EXTERN_C
 JNC_EXPORT_O
 void*
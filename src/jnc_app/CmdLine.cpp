@@ -110,6 +110,26 @@ CmdLineParser::onSwitch (
 		m_cmdLine->m_flags |= JncFlag_SimpleGcSafePoint;
 		break;
 
+	case CmdLineSwitch_Optimize:
+		m_cmdLine->m_flags |= JncFlag_Optimize;
+		break;
+
+	case CmdLineSwitch_HostCpu:
+		m_cmdLine->m_flags |= JncFlag_HostCpu;
+		break;
+
+	case CmdLineSwitch_StripLib:
+		m_cmdLine->m_flags |= JncFlag_StripUnusedLibFunctions;
+		break;
+
+	case CmdLineSwitch_Cpu:
+		m_cmdLine->m_cpu = value;
+		break;
+
+	case CmdLineSwitch_CpuFeatures:
+		m_cmdLine->m_cpuFeatures = value;
+		break;
+
 	case CmdLineSwitch_CompileOnly:
 		m_cmdLine->m_flags &= ~JncFlag_Run;
 		m_cmdLine->m_flags |= JncFlag_Compile;
@@ -175,6 +195,10 @@ CmdLineParser::onSwitch (
 		m_cmdLine->m_flags |= JncFlag_IgnoreOpaqueClassTypeInfo;
 		break;
 
+	case CmdLineSwitch_TimeReport:
+		m_cmdLine->m_flags |= JncFlag_TimeReport;
+		break;
+
 	case CmdLineSwitch_DisableDoxyComment:
 		DoxyCommentMap::Iterator it = DoxyCommentMap::find (value);
 		if (it)
@@ -29,6 +29,10 @@ enum JncFlag
 	JncFlag_PrintReturnValue          = 0x0800,
 	JncFlag_StdLibDoc                 = 0x1000,
 	JncFlag_IgnoreOpaqueClassTypeInfo = 0x2000,
+	JncFlag_TimeReport                = 0x4000,
+	JncFlag_Optimize                  = 0x8000,
+	JncFlag_HostCpu                   = 0x10000,
+	JncFlag_StripUnusedLibFunctions   = 0x20000,
 };
 
 struct CmdLine
@@ -42,6 +46,8 @@ struct CmdLine
 	sl::String m_functionName;
 	sl::String m_extensionSrcFileName;
 	sl::String m_outputDir;
+	sl::String m_cpu;
+	sl::String m_cpuFeatures;
 
 	sl::BoxList <sl::String> m_fileNameList;
 	sl::BoxList <sl::String> m_importDirList;
@@ -74,8 +80,14 @@ enum CmdLineSwitch
 	CmdLineSwitch_Jit,
 	CmdLineSwitch_McJit,
 	CmdLineSwitch_SimpleGcSafePoint,
+	CmdLineSwitch_Optimize,
+	CmdLineSwitch_HostCpu,
+	CmdLineSwitch_Cpu,
+	CmdLineSwitch_CpuFeatures,
+	CmdLineSwitch_StripLib,
 	CmdLineSwitch_StdLibDoc,
 	CmdLineSwitch_DisableDoxyComment,
+	CmdLineSwitch_TimeReport,
 	CmdLineSwitch_Run,
 	CmdLineSwitch_RunFunction,
 	CmdLineSwitch_GcAllocSizeTrigger,
@@ -169,6 +181,31 @@ AXL_SL_BEGIN_CMD_LINE_SWITCH_TABLE (CmdLineSwitchTable, CmdLineSwitch)
 		"simple-gc-safe-point", NULL,
 		"Use simple GC safe-point call (rather than guard page)"
 		)
+	AXL_SL_CMD_LINE_SWITCH (
+		CmdLineSwitch_Optimize,
+		"optimize", NULL,
+		"Run the optimizing tier on functions with loops"
+		)
+	AXL_SL_CMD_LINE_SWITCH (
+		CmdLineSwitch_HostCpu,
+		"host-cpu", NULL,
+		"JIT for the host CPU and all of its features"
+		)
+	AXL_SL_CMD_LINE_SWITCH (
+		CmdLineSwitch_Cpu,
+		"cpu", "<name>",
+		"JIT for a specific CPU (e.g. 'haswell')"
+		)
+	AXL_SL_CMD_LINE_SWITCH (
+		CmdLineSwitch_CpuFeatures,
+		"cpu-features", "<features>",
+		"Enable/disable specific CPU features (e.g. '+avx2,-bmi2')"
+		)
+	AXL_SL_CMD_LINE_SWITCH (
+		CmdLineSwitch_StripLib,
+		"strip-lib", NULL,
+		"Do not JIT library functions unreachable from the program"
+		)
 	AXL_SL_CMD_LINE_SWITCH (
 		CmdLineSwitch_StdLibDoc,
 		"std-lib-doc", NULL,
@@ -179,6 +216,11 @@ AXL_SL_BEGIN_CMD_LINE_SWITCH_TABLE (CmdLineSwitchTable, CmdLineSwitch)
 		"no-doxy-comment", "<doxy-comment>",
 		"Disable specific doxy comment (1-4): ///, //!, /**, /*!"
 		)
+	AXL_SL_CMD_LINE_SWITCH (
+		CmdLineSwitch_TimeReport,
+		"time-report", NULL,
+		"Print compile phase timing and counters"
+		)
 
 	AXL_SL_CMD_LINE_SWITCH_GROUP ("Runtime options")
 	AXL_SL_CMD_LINE_SWITCH_2 (
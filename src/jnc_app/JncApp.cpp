@@ -53,6 +53,15 @@ JncApp::JncApp (CmdLine* cmdLine)
 	if (cmdLine->m_flags & JncFlag_SimpleGcSafePoint)
 		compileFlags |= jnc::ModuleCompileFlag_SimpleGcSafePoint;
 
+	if (cmdLine->m_flags & JncFlag_Optimize)
+		compileFlags |= jnc::ModuleCompileFlag_Optimize;
+
+	if (cmdLine->m_flags & JncFlag_HostCpu)
+		compileFlags |= jnc::ModuleCompileFlag_HostCpu;
+
+	if (cmdLine->m_flags & JncFlag_StripUnusedLibFunctions)
+		compileFlags |= jnc::ModuleCompileFlag_StripUnusedLibFunctions;
+
 	if (cmdLine->m_flags & JncFlag_IgnoreOpaqueClassTypeInfo)
 		compileFlags |= jnc::ModuleCompileFlag_IgnoreOpaqueClassTypeInfo;
 
@@ -73,6 +82,9 @@ JncApp::JncApp (CmdLine* cmdLine)
 
 	m_module->initialize ("jnc_module", compileFlags);
 
+	if (!cmdLine->m_cpu.isEmpty () || !cmdLine->m_cpuFeatures.isEmpty ())
+		m_module->setJitCpu (cmdLine->m_cpu.sz (), cmdLine->m_cpuFeatures.sz ());
+
 	if (!(cmdLine->m_flags & JncFlag_StdLibDoc))
 	{
 		m_module->addStaticLib (jnc::StdLib_getLib ());
@@ -186,6 +198,42 @@ JncApp::runFunction (int* returnValue)
 	return true;
 }
 
+void
+JncApp::printTimeReport ()
+{
+	jnc::ModuleCompileStats stats;
+	m_module->getCompileStats (&stats);
+
+	printf ("%-28s %10s %10s\n", "phase", "wall (ms)", "cpu (ms)");
+
+	uint64_t totalWallTime = 0;
+	uint64_t totalCpuTime = 0;
+
+	for (size_t i = 0; i < jnc::ModuleCompilePhase__Count; i++)
+	{
+		const jnc::ModuleCompilePhaseTime* time = &stats.m_phaseTimeTable [i];
+		totalWallTime += time->m_wallTime;
+		totalCpuTime += time->m_cpuTime;
+
+		printf (
+			"%-28s %10.3f %10.3f\n",
+			jnc::getModuleCompilePhaseString ((jnc::ModuleCompilePhase) i),
+			(double) time->m_wallTime / 10000,
+			(double) time->m_cpuTime / 10000
+			);
+	}
+
+	printf ("%-28s %10.3f %10.3f\n\n", "total", (double) totalWallTime / 10000, (double) totalCpuTime / 10000);
+	printf ("tokens:            %d\n", (int) stats.m_tokenCount);
+	printf ("functions:         %d\n", (int) stats.m_functionCount);
+	printf ("types:             %d\n", (int) stats.m_typeCount);
+	printf ("LLVM instructions: %d\n", (int) stats.m_llvmInstructionCount);
+	printf ("machine code size: %d\n", (int) stats.m_machineCodeSize);
+	printf ("widened range checks: %d\n", (int) stats.m_widenedRangeCheckCount);
+	printf ("optimized functions: %d\n", (int) stats.m_optimizedFunctionCount);
+	printf ("stripped functions: %d\n", (int) stats.m_strippedFunctionCount);
+}
+
 bool
 JncApp::generateDocumentation ()
 {
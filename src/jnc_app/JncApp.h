@@ -47,6 +47,9 @@ public:
 		printf ("%s", m_module->getLlvmIrString_v ());
 	}
 
+	void
+	printTimeReport ();
+
 	bool
 	generateDocumentation ();
 
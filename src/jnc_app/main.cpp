@@ -148,6 +148,9 @@ main (
 			}
 		}
 
+		if (cmdLine.m_flags & JncFlag_TimeReport)
+			app.printTimeReport ();
+
 		if (cmdLine.m_flags & JncFlag_Run)
 		{
 			int returnValue;
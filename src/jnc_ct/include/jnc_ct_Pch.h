@@ -57,6 +57,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/IR/MDBuilder.h"
 
 // they moved things around in LLVM 3.5
 
@@ -67,6 +68,7 @@
 #	include "llvm/Analysis/Verifier.h"
 #else
 #	include "llvm/IR/PassManager.h"
+#	include "llvm/IR/LegacyPassManager.h"
 #	include "llvm/IR/DIBuilder.h"
 #	include "llvm/IR/DebugInfo.h"
 #	include "llvm/IR/Verifier.h"
@@ -77,12 +79,40 @@
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Support/Host.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "llvm/ADT/StringExtras.h"
 #include <llvm/ADT/StringMap.h>
 #include "llvm/Analysis/Passes.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/ScalarEvolution.h"
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+#include "llvm/Analysis/ScalarEvolutionExpressions.h"
+#include "llvm/InitializePasses.h"
+
+#if (LLVM_VERSION >= 0x0308)
+#	include "llvm/Analysis/BasicAliasAnalysis.h"
+#endif
+
 #include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/IPO.h"
+
+#if (LLVM_VERSION >= 0x0307)
+#	include "llvm/Transforms/InstCombine/InstCombine.h"
+#endif
+
+#if (LLVM_VERSION >= 0x0309)
+#	include "llvm/Transforms/Scalar/GVN.h"
+#endif
+
+#include "llvm/Transforms/Vectorize.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "llvm/Target/TargetMachine.h"
+
+#if (LLVM_VERSION >= 0x0307)
+#	include "llvm/Analysis/TargetTransformInfo.h"
+#endif
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 
 // LLVM JIT forces linkage to LLVM libraries if JIT is merely included;
@@ -225,6 +255,7 @@ const SyncScope::ID DefaultSynchronizationScope_vn = llvm::SyncScope::System;
 
 #include "axl_mem_Block.h"
 #include "axl_err_Errno.h"
+#include "axl_g_Module.h"
 #include "axl_sl_List.h"
 #include "axl_sl_ArrayList.h"
 #include "axl_sl_AutoPtrArray.h"
@@ -0,0 +1 @@
+#include "../jnc_ct_Parser/jnc_ct_TokenCache.h"
@@ -180,6 +180,12 @@ public:
 	void
 	finalizeFunction ();
 
+	bool
+	hasSjljFrames ()
+	{
+		return !m_sjljFrameArrayValue.isEmpty ();
+	}
+
 	// jumps
 
 	void
@@ -486,6 +492,9 @@ protected:
 
 	void
 	setSjljFrame (size_t index);
+
+	void
+	markLoop ();
 };
 
 //..............................................................................
@@ -367,6 +367,17 @@ ControlFlowMgr::reSwitchStmt_Finalize (ReSwitchStmt* stmt)
 
 // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
 
+void
+ControlFlowMgr::markLoop ()
+{
+	Function* function = m_module->m_functionMgr.getCurrentFunction ();
+	ASSERT (function);
+
+	function->m_flags |= FunctionFlag_HasLoop;
+}
+
+// . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
 void
 ControlFlowMgr::whileStmt_Create (WhileStmt* stmt)
 {
@@ -374,6 +385,7 @@ ControlFlowMgr::whileStmt_Create (WhileStmt* stmt)
 	stmt->m_bodyBlock = createBlock ("while_body");
 	stmt->m_followBlock = createBlock ("while_follow");
 	follow (stmt->m_conditionBlock);
+	markLoop ();
 }
 
 bool
@@ -407,6 +419,7 @@ ControlFlowMgr::doStmt_Create (DoStmt* stmt)
 	stmt->m_bodyBlock = createBlock ("do_body");
 	stmt->m_followBlock = createBlock ("do_follow");
 	follow (stmt->m_bodyBlock);
+	markLoop ();
 }
 
 void
@@ -447,6 +460,7 @@ ControlFlowMgr::forStmt_Create (ForStmt* stmt)
 	stmt->m_followBlock = createBlock ("for_follow");
 	stmt->m_conditionBlock = stmt->m_bodyBlock;
 	stmt->m_loopBlock = stmt->m_bodyBlock;
+	markLoop ();
 }
 
 void
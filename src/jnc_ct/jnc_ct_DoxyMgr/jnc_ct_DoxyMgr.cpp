@@ -34,6 +34,35 @@ DoxyMgr::clear ()
 	m_targetList.clear ();
 }
 
+size_t
+DoxyMgr::freeBlockText ()
+{
+	// blocks themselves stay as module items point to them
+
+	size_t size = 0;
+
+	sl::Iterator <DoxyBlock> it = m_blockList.getHead ();
+	for (; it; it++)
+	{
+		DoxyBlock* block = *it;
+
+		size +=
+			block->m_briefDescription.getLength () +
+			block->m_detailedDescription.getLength () +
+			block->m_seeAlsoDescription.getLength () +
+			block->m_internalDescription.getLength ();
+
+		block->m_briefDescription.clear ();
+		block->m_detailedDescription.clear ();
+		block->m_seeAlsoDescription.clear ();
+		block->m_internalDescription.clear ();
+		block->m_importList.clear ();
+	}
+
+	m_targetList.clear ();
+	return size;
+}
+
 DoxyGroup*
 DoxyMgr::getGroup (const sl::StringRef& name)
 {
@@ -93,6 +93,9 @@ public:
 	void
 	deleteEmptyGroups ();
 
+	size_t
+	freeBlockText (); // returns the number of bytes freed
+
 	bool
 	generateGroupDocumentation (
 		const sl::StringRef& outputDir,
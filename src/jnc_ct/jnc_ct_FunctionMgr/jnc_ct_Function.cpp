@@ -38,6 +38,7 @@ Function::Function ()
 	m_prologueBlock = NULL;
 	m_scope = NULL;
 	m_llvmFunction = NULL;
+	m_llvmInternalBody = NULL;
 	m_machineCode = NULL;
 }
 
@@ -32,6 +32,18 @@ class Scope;
 
 //..............................................................................
 
+// 0x010000 is taken by MulticastMethodFlag_InaccessibleViaEventPtr
+
+enum FunctionFlag
+{
+	FunctionFlag_InlineRangeCheck = 0x100000, // candidate for range-check hoisting
+	FunctionFlag_Overridden       = 0x200000, // overridden in some derived class
+	FunctionFlag_HasLoop          = 0x400000, // candidate for the optimized tier
+	FunctionFlag_HasSjljFrames    = 0x800000, // locals must stay in memory
+};
+
+//..............................................................................
+
 // shared between CFunction and COrphan
 
 class FunctionName
@@ -119,6 +131,8 @@ class Function:
 	friend class ExtensionNamespace;
 	friend class Orphan;
 	friend class Parser;
+	friend class OperatorMgr;
+	friend class ControlFlowMgr;
 
 protected:
 	FunctionType* m_type;
@@ -155,6 +169,7 @@ protected:
 	Scope* m_scope;
 
 	llvm::Function* m_llvmFunction;
+	llvm::Function* m_llvmInternalBody; // fastcc body for direct calls (optimized tier only)
 	llvm::DISubprogram_vn m_llvmDiSubprogram;
 
 	sl::Array <TlsVariable> m_tlsVariableArray;
@@ -300,6 +315,12 @@ public:
 	llvm::Function*
 	getLlvmFunction ();
 
+	llvm::Function*
+	getLlvmInternalBody ()
+	{
+		return m_llvmInternalBody;
+	}
+
 	llvm::DISubprogram_vn
 	getLlvmDiSubprogram ();
 
@@ -11,6 +11,7 @@
 
 #include "pch.h"
 #include "jnc_ct_FunctionMgr.h"
+#include "jnc_ct_RangeCheckWideningPass.h"
 #include "jnc_ct_Module.h"
 #include "jnc_ct_Parser.llk.h"
 
@@ -402,6 +403,15 @@ FunctionMgr::finalizeFunction (
 	m_module->m_operatorMgr.resetUnsafeRgn ();
 	m_module->m_variableMgr.finalizeLiftedStackVariables ();
 	m_module->m_gcShadowStackMgr.finalizeFunction ();
+
+	// setjmp/longjmp-based functions must not have locals promoted to registers
+
+	if (m_module->m_controlFlowMgr.hasSjljFrames ())
+	{
+		function->m_flags &= ~FunctionFlag_InlineRangeCheck;
+		function->m_flags |= FunctionFlag_HasSjljFrames;
+	}
+
 	m_module->m_controlFlowMgr.finalizeFunction ();
 
 	size_t count = function->m_tlsVariableArray.getCount ();
@@ -704,6 +714,446 @@ FunctionMgr::injectTlsPrologue (Function* function)
 		tlsVariableArray [i].m_llvmAlloca->eraseFromParent ();
 }
 
+void
+FunctionMgr::optimizeRangeChecks ()
+{
+	// run a light-weight pass pipeline over functions with inline range checks:
+	// promote locals, then rotate loops so that LICM can hoist invariant
+	// validator loads and EarlyCSE can merge repeated checks on the same pointer;
+	// checks on induction variables are widened to the whole loop range, and
+	// LoopUnswitch splits off a check-free copy of the loop
+
+#if (LLVM_VERSION < 0x0305)
+	llvm::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#else
+	llvm::legacy::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#endif
+
+#if (LLVM_VERSION < 0x0308)
+	llvmFpm.add (llvm::createBasicAliasAnalysisPass ());
+#else
+	llvmFpm.add (llvm::createBasicAAWrapperPass ());
+#endif
+
+	llvmFpm.add (llvm::createPromoteMemoryToRegisterPass ());
+	llvmFpm.add (llvm::createEarlyCSEPass ());
+	llvmFpm.add (llvm::createLoopRotatePass ());
+	llvmFpm.add (llvm::createLICMPass ());
+	llvmFpm.add (new RangeCheckWideningPass (m_module));
+	llvmFpm.add (llvm::createLoopUnswitchPass ());
+	llvmFpm.add (llvm::createEarlyCSEPass ());
+	llvmFpm.add (llvm::createCFGSimplificationPass ());
+	llvmFpm.doInitialization ();
+
+	// functions of the optimized tier have been taken care of already
+
+	uint_t skipFlags = (m_module->getCompileFlags () & ModuleCompileFlag_Optimize) ? FunctionFlag_HasLoop : 0;
+
+	sl::Iterator <Function> functionIt = m_functionList.getHead ();
+	for (; functionIt; functionIt++)
+	{
+		Function* function = *functionIt;
+		if ((function->m_flags & FunctionFlag_InlineRangeCheck) &&
+			!(function->m_flags & skipFlags) &&
+			function->getPrologueBlock ())
+			llvmFpm.run (*function->getLlvmFunction ());
+	}
+
+	llvmFpm.doFinalization ();
+}
+
+void
+FunctionMgr::optimizeHotFunctions ()
+{
+	// the optimized tier: functions with loops are where the time goes, so
+	// these get a full scalar & loop pipeline; straight-line code stays in
+	// the cheap tier to keep the start-up time low
+
+#if (LLVM_VERSION < 0x0305)
+	llvm::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#else
+	llvm::legacy::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#endif
+
+#if (LLVM_VERSION < 0x0308)
+	llvmFpm.add (llvm::createBasicAliasAnalysisPass ());
+#else
+	llvmFpm.add (llvm::createBasicAAWrapperPass ());
+#endif
+
+	llvmFpm.add (llvm::createSROAPass ());
+	llvmFpm.add (llvm::createEarlyCSEPass ());
+	llvmFpm.add (llvm::createInstructionCombiningPass ());
+	llvmFpm.add (llvm::createReassociatePass ());
+	llvmFpm.add (llvm::createCFGSimplificationPass ());
+	llvmFpm.add (llvm::createLoopRotatePass ());
+	llvmFpm.add (llvm::createLICMPass ());
+	llvmFpm.add (llvm::createIndVarSimplifyPass ());
+	llvmFpm.add (new RangeCheckWideningPass (m_module));
+	llvmFpm.add (llvm::createLoopUnswitchPass ());
+	llvmFpm.add (llvm::createLoopUnrollPass ());
+	llvmFpm.add (llvm::createGVNPass ());
+	llvmFpm.add (llvm::createInstructionCombiningPass ());
+	llvmFpm.add (llvm::createAggressiveDCEPass ());
+	llvmFpm.add (llvm::createCFGSimplificationPass ());
+	llvmFpm.doInitialization ();
+
+	size_t count = 0;
+
+	sl::Iterator <Function> functionIt = m_functionList.getHead ();
+	for (; functionIt; functionIt++)
+	{
+		Function* function = *functionIt;
+		if ((function->m_flags & FunctionFlag_HasLoop) &&
+			!(function->m_flags & FunctionFlag_HasSjljFrames) &&
+			function->getPrologueBlock ())
+		{
+			llvmFpm.run (*function->getLlvmFunction ());
+			count++;
+		}
+	}
+
+	llvmFpm.doFinalization ();
+	m_module->addOptimizedFunctionCount (count);
+}
+
+void
+FunctionMgr::vectorizeHotFunctions ()
+{
+	// vectorizers need the cost model of the actual target, so this part of
+	// the optimized tier runs after the execution engine has been created
+
+	// there are no first-class vector types in Jancy -- only plain loops over
+	// arrays and data pointers are candidates. the loop vectorizer rejects
+	// loops with more than one exit, and every range check which stays in
+	// the loop is such an exit; only loops whose checks were widened and
+	// then unswitched into a check-free copy can get SIMD code
+
+	llvm::TargetMachine* llvmTargetMachine = m_module->getLlvmExecutionEngine ()->getTargetMachine ();
+	if (!llvmTargetMachine)
+		return;
+
+#if (LLVM_VERSION < 0x0305)
+	llvm::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#else
+	llvm::legacy::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#endif
+
+#if (LLVM_VERSION < 0x0307)
+	llvmTargetMachine->addAnalysisPasses (llvmFpm);
+#else
+	llvmFpm.add (llvm::createTargetTransformInfoWrapperPass (llvmTargetMachine->getTargetIRAnalysis ()));
+#endif
+
+#if (LLVM_VERSION < 0x0308)
+	llvmFpm.add (llvm::createBasicAliasAnalysisPass ());
+#else
+	llvmFpm.add (llvm::createBasicAAWrapperPass ());
+#endif
+
+	llvmFpm.add (llvm::createLoopVectorizePass ());
+	llvmFpm.add (llvm::createSLPVectorizerPass ());
+	llvmFpm.add (llvm::createInstructionCombiningPass ());
+	llvmFpm.add (llvm::createCFGSimplificationPass ());
+	llvmFpm.doInitialization ();
+
+	sl::Iterator <Function> functionIt = m_functionList.getHead ();
+	for (; functionIt; functionIt++)
+	{
+		Function* function = *functionIt;
+		if ((function->m_flags & FunctionFlag_HasLoop) &&
+			!(function->m_flags & FunctionFlag_HasSjljFrames) &&
+			function->getPrologueBlock ())
+		{
+			llvmFpm.run (*function->getLlvmFunction ());
+
+			if (function->m_llvmInternalBody) // loops live in the body
+				llvmFpm.run (*function->m_llvmInternalBody);
+		}
+	}
+
+	llvmFpm.doFinalization ();
+}
+
+static
+bool
+hasAggregateArgs (llvm::Function* llvmFunction)
+{
+	llvm::Function::arg_iterator llvmArg = llvmFunction->arg_begin ();
+	for (; llvmArg != llvmFunction->arg_end (); llvmArg++)
+		if (llvmArg->hasByValAttr () || llvmArg->hasStructRetAttr ())
+			return true;
+
+	return false;
+}
+
+void
+FunctionMgr::optimizeInternalCalls ()
+{
+	// only the entry points visible to the host and extension libs have to
+	// follow the C ABI; calls between Jancy functions are free to use a faster
+	// convention. every function which is called directly and takes fat
+	// pointers or aggregates by value gets an internal fastcc body, the
+	// original function becomes a C-ABI entry forwarding to this body, and
+	// all direct calls are redirected to the body
+
+	sl::Array <Function*> functionArray;
+	sl::Array <llvm::CallInst*> llvmCallArray;
+
+	sl::Iterator <Function> functionIt = m_functionList.getHead ();
+	for (; functionIt; functionIt++)
+	{
+		Function* function = *functionIt;
+		if ((function->m_flags & FunctionFlag_HasSjljFrames) ||
+			!function->getPrologueBlock () ||
+			!(function->getType ()->getCallConv ()->getFlags () & CallConvFlag_Jnccall))
+			continue;
+
+		llvm::Function* llvmFunction = function->getLlvmFunction ();
+		if (llvmFunction->isVarArg () ||
+			llvmFunction->isDeclaration () ||
+			!llvmFunction->hasName () ||
+			!hasAggregateArgs (llvmFunction))
+			continue;
+
+		llvmCallArray.clear ();
+		collectDirectCalls (llvmFunction, &llvmCallArray);
+		if (llvmCallArray.isEmpty ())
+			continue;
+
+		llvm::Function* llvmBody = createInternalBody (llvmFunction);
+
+		size_t count = llvmCallArray.getCount ();
+		for (size_t i = 0; i < count; i++)
+		{
+			llvmCallArray [i]->setCalledFunction (llvmBody);
+			llvmCallArray [i]->setCallingConv (llvm::CallingConv::Fast);
+		}
+
+		functionArray.append (function);
+	}
+
+	if (functionArray.isEmpty ())
+		return;
+
+	// internal bodies have all the call sites known, so fat pointers passed
+	// byval can now be split into scalars and passed in registers
+
+#if (LLVM_VERSION < 0x0305)
+	llvm::PassManager llvmPm;
+#else
+	llvm::legacy::PassManager llvmPm;
+#endif
+
+	llvmPm.add (llvm::createArgumentPromotionPass ());
+	llvmPm.run (*m_module->getLlvmModule ());
+
+	// argument promotion re-creates the bodies, so pick them up from the
+	// forwarding calls. entries which are also reached through pointers
+	// (vtables, function pointers, thunks) get the body inlined -- this
+	// saves the extra hop on indirect and virtual calls
+
+	size_t count = functionArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+	{
+		Function* function = functionArray [i];
+		llvm::Function* llvmFunction = function->getLlvmFunction ();
+		llvm::CallInst* llvmCall = findForwardingCall (llvmFunction);
+		ASSERT (llvmCall && llvmCall->getCalledFunction ());
+
+		function->m_llvmInternalBody = llvmCall->getCalledFunction ();
+
+		if (!llvmFunction->use_empty ())
+		{
+			llvm::InlineFunctionInfo llvmInlineInfo;
+			llvm::InlineFunction (llvmCall, llvmInlineInfo);
+		}
+	}
+
+#if (LLVM_VERSION < 0x0305)
+	llvm::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#else
+	llvm::legacy::FunctionPassManager llvmFpm (m_module->getLlvmModule ());
+#endif
+
+	llvmFpm.add (llvm::createSROAPass ());
+	llvmFpm.add (llvm::createInstructionCombiningPass ());
+	llvmFpm.add (llvm::createCFGSimplificationPass ());
+	llvmFpm.doInitialization ();
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Function* function = functionArray [i];
+		llvmFpm.run (*function->m_llvmInternalBody);
+
+		if (!function->getLlvmFunction ()->use_empty ())
+			llvmFpm.run (*function->getLlvmFunction ());
+	}
+
+	llvmFpm.doFinalization ();
+}
+
+llvm::CallInst*
+FunctionMgr::findForwardingCall (llvm::Function* llvmFunction)
+{
+	// argument promotion may have put loads of promoted fields before the call
+
+	llvm::BasicBlock* llvmBlock = &llvmFunction->getEntryBlock ();
+	llvm::BasicBlock::iterator llvmInstIt = llvmBlock->begin ();
+	for (; llvmInstIt != llvmBlock->end (); llvmInstIt++)
+	{
+		llvm::CallInst* llvmCall = llvm::dyn_cast <llvm::CallInst> (&*llvmInstIt);
+		if (llvmCall)
+			return llvmCall;
+	}
+
+	return NULL;
+}
+
+void
+FunctionMgr::collectDirectCalls (
+	llvm::Function* llvmFunction,
+	sl::Array <llvm::CallInst*>* llvmCallArray
+	)
+{
+#if (LLVM_VERSION < 0x0305)
+	llvm::Value::use_iterator it = llvmFunction->use_begin ();
+	llvm::Value::use_iterator end = llvmFunction->use_end ();
+#else
+	llvm::Value::user_iterator it = llvmFunction->user_begin ();
+	llvm::Value::user_iterator end = llvmFunction->user_end ();
+#endif
+
+	for (; it != end; it++)
+	{
+		llvm::CallInst* llvmCall = llvm::dyn_cast <llvm::CallInst> (*it);
+		if (llvmCall &&
+			llvmCall->getCalledValue () == llvmFunction &&
+			llvmCall->getCallingConv () == llvmFunction->getCallingConv ())
+			llvmCallArray->append (llvmCall);
+	}
+}
+
+llvm::Function*
+FunctionMgr::createInternalBody (llvm::Function* llvmFunction)
+{
+	llvm::Function* llvmBody = llvm::Function::Create (
+		llvmFunction->getFunctionType (),
+		llvm::GlobalValue::InternalLinkage,
+		llvmFunction->getName () + ".body",
+		m_module->getLlvmModule ()
+		);
+
+	llvmBody->copyAttributesFrom (llvmFunction);
+	llvmBody->setCallingConv (llvm::CallingConv::Fast);
+	llvmBody->getBasicBlockList ().splice (llvmBody->end (), llvmFunction->getBasicBlockList ());
+
+	char buffer [256];
+	sl::Array <llvm::Value*> llvmArgValueArray (ref::BufKind_Stack, buffer, sizeof (buffer));
+
+	llvm::Function::arg_iterator llvmArg = llvmFunction->arg_begin ();
+	llvm::Function::arg_iterator llvmBodyArg = llvmBody->arg_begin ();
+	for (; llvmArg != llvmFunction->arg_end (); llvmArg++, llvmBodyArg++)
+	{
+		llvmArg->replaceAllUsesWith (&*llvmBodyArg);
+		llvmBodyArg->takeName (&*llvmArg);
+		llvmArgValueArray.append (&*llvmArg);
+	}
+
+	// the C-ABI entry just forwards to the body
+
+	llvm::BasicBlock* llvmBlock = llvm::BasicBlock::Create (*m_module->getLlvmContext (), "entry", llvmFunction);
+	llvm::IRBuilder <> llvmIrBuilder (llvmBlock);
+
+	llvm::CallInst* llvmCall = llvmIrBuilder.CreateCall (
+		llvmBody,
+		llvm::ArrayRef <llvm::Value*> (llvmArgValueArray, llvmArgValueArray.getCount ())
+		);
+
+	llvmCall->setCallingConv (llvm::CallingConv::Fast);
+	llvmCall->setAttributes (llvmFunction->getAttributes ());
+	llvmCall->setTailCall ();
+
+	if (llvmFunction->getReturnType ()->isVoidTy ())
+		llvmIrBuilder.CreateRetVoid ();
+	else
+		llvmIrBuilder.CreateRet (llvmCall);
+
+	return llvmBody;
+}
+
+static
+bool
+isLlvmFunctionUsed (llvm::Function* llvmFunction)
+{
+#if (LLVM_VERSION < 0x0305)
+	llvm::Value::use_iterator it = llvmFunction->use_begin ();
+	llvm::Value::use_iterator end = llvmFunction->use_end ();
+#else
+	llvm::Value::user_iterator it = llvmFunction->user_begin ();
+	llvm::Value::user_iterator end = llvmFunction->user_end ();
+#endif
+
+	for (; it != end; it++)
+	{
+		// recursive calls don't make a function reachable
+
+		llvm::Instruction* llvmInst = llvm::dyn_cast <llvm::Instruction> (*it);
+		if (!llvmInst || llvmInst->getParent ()->getParent () != llvmFunction)
+			return true;
+	}
+
+	return false;
+}
+
+size_t
+FunctionMgr::stripUnusedLibFunctions ()
+{
+	// extension libs contribute their sources in full, but most programs only
+	// use a fraction of those. all the roots (static constructors, vtables,
+	// property tables, thunks, type info) reference the functions they need
+	// from the LLVM IR, so a library function without such references is
+	// unreachable -- drop its body and don't JIT it. dropping a body releases
+	// its own references, so repeat until nothing changes
+
+	size_t count = 0;
+	bool isChanged;
+
+	do
+	{
+		isChanged = false;
+
+		sl::Iterator <Function> functionIt = m_functionList.getHead ();
+		for (; functionIt; functionIt++)
+		{
+			Function* function = *functionIt;
+			if (!function->getPrologueBlock ())
+				continue;
+
+			FunctionKind functionKind = function->getFunctionKind ();
+			if (functionKind != FunctionKind_Named &&
+				functionKind != FunctionKind_Getter &&
+				functionKind != FunctionKind_Setter)
+				continue;
+
+			Unit* unit = function->getParentUnit ();
+			if (!unit || !unit->getLib ())
+				continue;
+
+			llvm::Function* llvmFunction = function->getLlvmFunction ();
+			if (llvmFunction->isDeclaration () || isLlvmFunctionUsed (llvmFunction))
+				continue;
+
+			llvmFunction->deleteBody ();
+			function->m_prologueBlock = NULL; // won't be jitted; getMachineCode () returns NULL
+			isChanged = true;
+			count++;
+		}
+	} while (isChanged);
+
+	return count;
+}
+
 void
 llvmFatalErrorHandler (
 	void* context,
@@ -750,6 +1200,54 @@ FunctionMgr::jitFunctions ()
 	return true;
 }
 
+size_t
+FunctionMgr::freeFunctionBodies ()
+{
+	size_t size = 0;
+
+	sl::Iterator <Function> functionIt = m_functionList.getHead ();
+	for (; functionIt; functionIt++)
+	{
+		Function* function = *functionIt;
+		size += function->m_body.getCount () * sizeof (Token);
+		function->m_body.clear ();
+	}
+
+	return size;
+}
+
+size_t
+FunctionMgr::freeLlvmFunctionBodies ()
+{
+	// machine code is already emitted; the execution engine only needs
+	// declarations (and global variables) to resolve addresses from now on
+
+	size_t size = 0;
+
+	llvm::Module* llvmModule = m_module->getLlvmModule ();
+	llvm::Module::iterator llvmFunctionIt = llvmModule->begin ();
+	for (; llvmFunctionIt != llvmModule->end (); llvmFunctionIt++)
+	{
+		llvm::Function* llvmFunction = &*llvmFunctionIt;
+		if (llvmFunction->isDeclaration ())
+			continue;
+
+		llvm::Function::iterator llvmBlockIt = llvmFunction->begin ();
+		for (; llvmBlockIt != llvmFunction->end (); llvmBlockIt++)
+		{
+			size += sizeof (llvm::BasicBlock);
+
+			llvm::BasicBlock::iterator llvmInstIt = llvmBlockIt->begin ();
+			for (; llvmInstIt != llvmBlockIt->end (); llvmInstIt++)
+				size += sizeof (llvm::Instruction) + llvmInstIt->getNumOperands () * sizeof (llvm::Use);
+		}
+
+		llvmFunction->deleteBody ();
+	}
+
+	return size;
+}
+
 Function*
 FunctionMgr::getStdFunction (StdFunc func)
 {
@@ -236,9 +236,44 @@ public:
 	bool
 	injectTlsPrologues ();
 
+	void
+	optimizeRangeChecks ();
+
+	void
+	optimizeHotFunctions ();
+
+	void
+	vectorizeHotFunctions ();
+
+	void
+	optimizeInternalCalls ();
+
+	size_t
+	stripUnusedLibFunctions (); // returns the number of stripped functions
+
 	bool
 	jitFunctions ();
 
+	size_t
+	freeFunctionBodies (); // returns the approximate number of bytes freed
+
+	size_t
+	freeLlvmFunctionBodies (); // returns the approximate number of bytes freed
+
+protected:
+	llvm::Function*
+	createInternalBody (llvm::Function* llvmFunction);
+
+	llvm::CallInst*
+	findForwardingCall (llvm::Function* llvmFunction);
+
+	void
+	collectDirectCalls (
+		llvm::Function* llvmFunction,
+		sl::Array <llvm::CallInst*>* llvmCallArray
+		);
+
+public:
 	// std functions
 
 	bool
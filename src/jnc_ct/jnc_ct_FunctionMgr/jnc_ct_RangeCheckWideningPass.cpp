@@ -0,0 +1,373 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#include "pch.h"
+#include "jnc_ct_RangeCheckWideningPass.h"
+#include "jnc_ct_Module.h"
+
+namespace jnc {
+namespace ct {
+
+//..............................................................................
+
+char RangeCheckWideningPass::ID = 0;
+
+RangeCheckWideningPass::RangeCheckWideningPass (Module* module):
+	llvm::FunctionPass (ID)
+{
+	m_module = module;
+	m_llvmLoopInfo = NULL;
+	m_llvmSe = NULL;
+
+	// we are not registered, so make sure the analyses we require are
+
+	llvm::PassRegistry* llvmRegistry = llvm::PassRegistry::getPassRegistry ();
+
+#if (LLVM_VERSION < 0x0307)
+	llvm::initializeLoopInfoPass (*llvmRegistry);
+#else
+	llvm::initializeLoopInfoWrapperPassPass (*llvmRegistry);
+#endif
+
+#if (LLVM_VERSION < 0x0308)
+	llvm::initializeScalarEvolutionPass (*llvmRegistry);
+#else
+	llvm::initializeScalarEvolutionWrapperPassPass (*llvmRegistry);
+#endif
+}
+
+void
+RangeCheckWideningPass::getAnalysisUsage (llvm::AnalysisUsage& analysisUsage) const
+{
+#if (LLVM_VERSION < 0x0307)
+	analysisUsage.addRequired <llvm::LoopInfo> ();
+#else
+	analysisUsage.addRequired <llvm::LoopInfoWrapperPass> ();
+#endif
+
+#if (LLVM_VERSION < 0x0308)
+	analysisUsage.addRequired <llvm::ScalarEvolution> ();
+#else
+	analysisUsage.addRequired <llvm::ScalarEvolutionWrapperPass> ();
+#endif
+
+	analysisUsage.setPreservesCFG ();
+}
+
+bool
+RangeCheckWideningPass::runOnFunction (llvm::Function& llvmFunction)
+{
+#if (LLVM_VERSION < 0x0307)
+	m_llvmLoopInfo = &getAnalysis <llvm::LoopInfo> ();
+#else
+	m_llvmLoopInfo = &getAnalysis <llvm::LoopInfoWrapperPass> ().getLoopInfo ();
+#endif
+
+#if (LLVM_VERSION < 0x0308)
+	m_llvmSe = &getAnalysis <llvm::ScalarEvolution> ();
+#else
+	m_llvmSe = &getAnalysis <llvm::ScalarEvolutionWrapperPass> ().getSE ();
+#endif
+
+	// collect checks first -- widening inserts new instructions;
+	// inline range checks are the only branches we annotate with weights
+
+	sl::Array <llvm::BranchInst*> llvmBranchArray;
+
+	llvm::Function::iterator llvmBlock = llvmFunction.begin ();
+	for (; llvmBlock != llvmFunction.end (); llvmBlock++)
+	{
+		if (!m_llvmLoopInfo->getLoopFor (&*llvmBlock))
+			continue;
+
+		llvm::BranchInst* llvmBranch = llvm::dyn_cast <llvm::BranchInst> (llvmBlock->getTerminator ());
+		if (llvmBranch &&
+			llvmBranch->isConditional () &&
+			llvmBranch->getMetadata (llvm::LLVMContext::MD_prof))
+			llvmBranchArray.append (llvmBranch);
+	}
+
+	size_t widenedCount = 0;
+
+	size_t count = llvmBranchArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+		if (widenCheck (llvmBranchArray [i]))
+			widenedCount++;
+
+	if (!widenedCount)
+		return false;
+
+	m_module->addWidenedRangeCheckCount (widenedCount);
+	return true;
+}
+
+bool
+RangeCheckWideningPass::widenCheck (llvm::BranchInst* llvmBranch)
+{
+	// the fail condition is either a single comparison or an 'or' of two
+
+	CmpInfo cmpInfoArray [2];
+	size_t cmpCount;
+
+	llvm::Value* llvmCondition = llvmBranch->getCondition ();
+	llvm::BinaryOperator* llvmOr = llvm::dyn_cast <llvm::BinaryOperator> (llvmCondition);
+	if (llvmOr && llvmOr->getOpcode () == llvm::Instruction::Or)
+	{
+		if (!getCmpInfo (llvmOr->getOperand (0), &cmpInfoArray [0]) ||
+			!getCmpInfo (llvmOr->getOperand (1), &cmpInfoArray [1]))
+			return false;
+
+		cmpCount = 2;
+	}
+	else
+	{
+		if (!getCmpInfo (llvmCondition, &cmpInfoArray [0]))
+			return false;
+
+		cmpCount = 1;
+	}
+
+	// all the recurrences must be over the same loop (which contains the check)
+
+	llvm::Loop* llvmLoop = NULL;
+
+	for (size_t i = 0; i < cmpCount; i++)
+	{
+		const llvm::SCEVAddRecExpr* addRec = cmpInfoArray [i].m_addRec;
+		if (!addRec)
+			continue;
+
+		if (!llvmLoop)
+			llvmLoop = const_cast <llvm::Loop*> (addRec->getLoop ());
+		else if (addRec->getLoop () != llvmLoop)
+			return false;
+	}
+
+	if (!llvmLoop || !llvmLoop->contains (llvmBranch->getParent ()))
+		return false; // nothing varies, LICM takes care of invariant checks
+
+	llvm::BasicBlock* llvmPreheader = llvmLoop->getLoopPreheader ();
+	llvm::BasicBlock* llvmLatch = llvmLoop->getLoopLatch ();
+	if (!llvmPreheader || !llvmLatch)
+		return false;
+
+	// every iteration passes through the latch, so its exit count bounds
+	// the number of iterations no matter which exit is actually taken
+
+	const llvm::SCEV* exitCount = m_llvmSe->getExitCount (llvmLoop, llvmLatch);
+	if (llvm::isa <llvm::SCEVCouldNotCompute> (exitCount) || !isSafeToExpand (exitCount))
+		return false;
+
+	for (size_t i = 0; i < cmpCount; i++)
+	{
+		const CmpInfo& cmpInfo = cmpInfoArray [i];
+		if (!cmpInfo.m_addRec)
+		{
+			if (!llvmLoop->isLoopInvariant (cmpInfo.m_llvmCmp->getOperand (0)) ||
+				!llvmLoop->isLoopInvariant (cmpInfo.m_llvmCmp->getOperand (1)))
+				return false;
+
+			continue;
+		}
+
+		const llvm::SCEVConstant* step = llvm::dyn_cast <llvm::SCEVConstant> (cmpInfo.m_addRec->getStepRecurrence (*m_llvmSe));
+		if (!cmpInfo.m_addRec->isAffine () ||
+			!step ||
+			step->getValue ()->isZero () ||
+			step->getValue ()->getValue ().isMinSignedValue () ||
+			!llvmLoop->isLoopInvariant (cmpInfo.m_llvmBound) ||
+			!isSafeToExpand (cmpInfo.m_addRec->getStart ()) ||
+			m_llvmSe->getTypeSizeInBits (exitCount->getType ()) > m_llvmSe->getTypeSizeInBits (cmpInfo.m_addRec->getType ()))
+			return false;
+	}
+
+	// whole-range check in the preheader
+
+	llvm::Instruction* llvmInsertPoint = llvmPreheader->getTerminator ();
+	llvm::Value* llvmOk = NULL;
+
+	for (size_t i = 0; i < cmpCount; i++)
+	{
+		llvm::Value* llvmCmpOk;
+
+		if (cmpInfoArray [i].m_addRec)
+		{
+			llvmCmpOk = createWholeRangeCheck (cmpInfoArray [i], exitCount, llvmInsertPoint);
+		}
+		else
+		{
+			llvm::Instruction* llvmCmp = cmpInfoArray [i].m_llvmCmp->clone ();
+			llvmCmp->insertBefore (llvmInsertPoint);
+			llvmCmpOk = llvm::BinaryOperator::CreateNot (llvmCmp, "range_ok", llvmInsertPoint);
+		}
+
+		llvmOk = llvmOk ?
+			llvm::BinaryOperator::CreateAnd (llvmOk, llvmCmpOk, "range_ok", llvmInsertPoint) :
+			llvmCmpOk;
+	}
+
+	// fail = !ok && fail -- equivalent, as ok implies that fail is false
+
+	llvm::Value* llvmNotOk = llvm::BinaryOperator::CreateNot (llvmOk, "range_partial", llvmInsertPoint);
+	llvmCondition = llvm::BinaryOperator::CreateAnd (llvmNotOk, llvmCondition, "range_fail", llvmBranch);
+	llvmBranch->setCondition (llvmCondition);
+	return true;
+}
+
+bool
+RangeCheckWideningPass::getCmpInfo (
+	llvm::Value* llvmValue,
+	CmpInfo* cmpInfo
+	)
+{
+	llvm::ICmpInst* llvmCmp = llvm::dyn_cast <llvm::ICmpInst> (llvmValue);
+	if (!llvmCmp || llvmCmp->isSigned () || llvmCmp->isEquality ())
+		return false;
+
+	llvm::Value* llvmOp0 = llvmCmp->getOperand (0);
+	llvm::Value* llvmOp1 = llvmCmp->getOperand (1);
+	if (!m_llvmSe->isSCEVable (llvmOp0->getType ()))
+		return false;
+
+	cmpInfo->m_llvmCmp = llvmCmp;
+
+	cmpInfo->m_addRec = llvm::dyn_cast <llvm::SCEVAddRecExpr> (m_llvmSe->getSCEV (llvmOp0));
+	if (cmpInfo->m_addRec)
+	{
+		cmpInfo->m_llvmBound = llvmOp1;
+		cmpInfo->m_predicate = llvmCmp->getPredicate ();
+		return true;
+	}
+
+	cmpInfo->m_addRec = llvm::dyn_cast <llvm::SCEVAddRecExpr> (m_llvmSe->getSCEV (llvmOp1));
+	if (cmpInfo->m_addRec)
+	{
+		cmpInfo->m_llvmBound = llvmOp0;
+		cmpInfo->m_predicate = llvmCmp->getSwappedPredicate ();
+		return true;
+	}
+
+	cmpInfo->m_llvmBound = NULL;
+	cmpInfo->m_predicate = llvmCmp->getPredicate ();
+	return true;
+}
+
+llvm::Value*
+RangeCheckWideningPass::createWholeRangeCheck (
+	const CmpInfo& cmpInfo,
+	const llvm::SCEV* exitCount,
+	llvm::Instruction* llvmInsertPoint
+	)
+{
+	// x [i] = start + step * i, for i in [0, exitCount]; if that doesn't wrap,
+	// all the values lie between x [0] and x [exitCount], and it's enough to
+	// check the one extreme which the comparison is sensitive to
+
+#if (LLVM_VERSION < 0x0307)
+	llvm::SCEVExpander llvmExpander (*m_llvmSe, "range");
+#else
+	llvm::Module* llvmModule = llvmInsertPoint->getParent ()->getParent ()->getParent ();
+	llvm::SCEVExpander llvmExpander (*m_llvmSe, llvmModule->getDataLayout (), "range");
+#endif
+
+	llvm::Type* llvmType = m_llvmSe->getEffectiveSCEVType (cmpInfo.m_addRec->getType ()); // intptr for pointers
+	llvm::IRBuilder <> llvmIrb (llvmInsertPoint);
+
+	llvm::Value* llvmStart = llvmExpander.expandCodeFor (cmpInfo.m_addRec->getStart (), llvmType, llvmInsertPoint);
+	llvm::Value* llvmCount = llvmExpander.expandCodeFor (exitCount, exitCount->getType (), llvmInsertPoint);
+	llvmCount = llvmIrb.CreateZExtOrBitCast (llvmCount, llvmType);
+
+	llvm::Value* llvmBound = cmpInfo.m_llvmBound;
+	if (llvmBound->getType ()->isPointerTy ())
+		llvmBound = llvmIrb.CreatePtrToInt (llvmBound, llvmType);
+
+	const llvm::SCEVConstant* step = llvm::cast <llvm::SCEVConstant> (cmpInfo.m_addRec->getStepRecurrence (*m_llvmSe));
+	llvm::APInt stepValue = step->getValue ()->getValue ();
+	bool isDecreasing = stepValue.isNegative ();
+	if (isDecreasing)
+		stepValue = -stepValue;
+
+	llvm::Value* llvmStep = llvm::ConstantInt::get (llvmType, stepValue);
+	llvm::Value* llvmSpan = llvmIrb.CreateMul (llvmCount, llvmStep);
+	llvm::Value* llvmLimit;
+	llvm::Value* llvmMin;
+	llvm::Value* llvmMax;
+
+	if (!isDecreasing)
+	{
+		llvmLimit = llvmIrb.CreateUDiv (llvmIrb.CreateNot (llvmStart), llvmStep); // (UMAX - start) / step
+		llvmMin = llvmStart;
+		llvmMax = llvmIrb.CreateAdd (llvmStart, llvmSpan);
+	}
+	else
+	{
+		llvmLimit = llvmIrb.CreateUDiv (llvmStart, llvmStep);
+		llvmMin = llvmIrb.CreateSub (llvmStart, llvmSpan);
+		llvmMax = llvmStart;
+	}
+
+	llvm::Value* llvmNoWrap = llvmIrb.CreateICmpULE (llvmCount, llvmLimit);
+
+	// x < bound or x <= bound fail on the minimum, x > bound or x >= bound on the maximum
+
+	llvm::Value* llvmExtreme =
+		cmpInfo.m_predicate == llvm::CmpInst::ICMP_ULT ||
+		cmpInfo.m_predicate == llvm::CmpInst::ICMP_ULE ?
+			llvmMin :
+			llvmMax;
+
+	llvm::Value* llvmInRange = llvmIrb.CreateICmp (
+		llvm::CmpInst::getInversePredicate (cmpInfo.m_predicate),
+		llvmExtreme,
+		llvmBound
+		);
+
+	return llvmIrb.CreateAnd (llvmNoWrap, llvmInRange, "range_ok");
+}
+
+bool
+RangeCheckWideningPass::isSafeToExpand (const llvm::SCEV* scev)
+{
+	// expansion must not trap (division by a non-constant) and must not
+	// create new recurrences (those belong to other loops)
+
+	if (llvm::isa <llvm::SCEVConstant> (scev) || llvm::isa <llvm::SCEVUnknown> (scev))
+		return true;
+
+	if (llvm::isa <llvm::SCEVAddRecExpr> (scev))
+		return false;
+
+	if (const llvm::SCEVCastExpr* castExpr = llvm::dyn_cast <llvm::SCEVCastExpr> (scev))
+		return isSafeToExpand (castExpr->getOperand ());
+
+	if (const llvm::SCEVUDivExpr* udivExpr = llvm::dyn_cast <llvm::SCEVUDivExpr> (scev))
+	{
+		const llvm::SCEVConstant* divisor = llvm::dyn_cast <llvm::SCEVConstant> (udivExpr->getRHS ());
+		return divisor && !divisor->getValue ()->isZero () && isSafeToExpand (udivExpr->getLHS ());
+	}
+
+	if (const llvm::SCEVNAryExpr* naryExpr = llvm::dyn_cast <llvm::SCEVNAryExpr> (scev))
+	{
+		size_t count = naryExpr->getNumOperands ();
+		for (size_t i = 0; i < count; i++)
+			if (!isSafeToExpand (naryExpr->getOperand (i)))
+				return false;
+
+		return true;
+	}
+
+	return false;
+}
+
+//..............................................................................
+
+} // namespace ct
+} // namespace jnc
@@ -0,0 +1,95 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#pragma once
+
+namespace jnc {
+namespace ct {
+
+class Module;
+
+//..............................................................................
+
+// induction-variable based elimination of inline range checks: for a check on
+// a pointer which advances by a constant step each iteration, a single check
+// covering the whole range of the loop is computed in the preheader. the
+// per-iteration check is then only taken if the whole-range check fails, so
+// LoopUnswitch can split off a copy of the loop without any checks
+
+class RangeCheckWideningPass: public llvm::FunctionPass
+{
+protected:
+	struct CmpInfo
+	{
+		llvm::ICmpInst* m_llvmCmp;
+		const llvm::SCEVAddRecExpr* m_addRec; // NULL if the comparison is loop-invariant
+		llvm::Value* m_llvmBound;
+		llvm::CmpInst::Predicate m_predicate; // m_addRec <predicate> m_llvmBound
+	};
+
+public:
+	static char ID;
+
+protected:
+	Module* m_module;
+	llvm::LoopInfo* m_llvmLoopInfo;
+	llvm::ScalarEvolution* m_llvmSe;
+
+public:
+	RangeCheckWideningPass (Module* module);
+
+#if (LLVM_VERSION < 0x0400)
+	virtual
+	const char*
+	getPassName () const
+#else
+	virtual
+	llvm::StringRef
+	getPassName () const
+#endif
+	{
+		return "Jancy range check widening";
+	}
+
+	virtual
+	void
+	getAnalysisUsage (llvm::AnalysisUsage& analysisUsage) const;
+
+	virtual
+	bool
+	runOnFunction (llvm::Function& llvmFunction);
+
+protected:
+	bool
+	widenCheck (llvm::BranchInst* llvmBranch);
+
+	bool
+	getCmpInfo (
+		llvm::Value* llvmValue,
+		CmpInfo* cmpInfo
+		);
+
+	llvm::Value*
+	createWholeRangeCheck (
+		const CmpInfo& cmpInfo,
+		const llvm::SCEV* exitCount,
+		llvm::Instruction* llvmInsertPoint
+		);
+
+	static
+	bool
+	isSafeToExpand (const llvm::SCEV* scev);
+};
+
+//..............................................................................
+
+} // namespace ct
+} // namespace jnc
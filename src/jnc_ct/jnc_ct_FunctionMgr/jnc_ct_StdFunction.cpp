@@ -138,6 +138,11 @@ getStdFunctionSource (StdFunc stdFunc)
 			lengthof (appendFmtLiteralSrc_v),
 			StdNamespace_Internal,
 		},
+		{                                        // StdFunc_ReserveFmtLiteral,
+			reserveFmtLiteralSrc,
+			lengthof (reserveFmtLiteralSrc),
+			StdNamespace_Internal,
+		},
 		{ NULL },                                // StdFunc_SimpleMulticastCall,
 		{                                        // StdFunc_AssertionFailure,
 			assertionFailureSrc,
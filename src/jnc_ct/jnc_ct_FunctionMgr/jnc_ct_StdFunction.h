@@ -65,6 +65,7 @@ enum StdFunc
 	StdFunc_AppendFmtLiteral_ui64,
 	StdFunc_AppendFmtLiteral_f,
 	StdFunc_AppendFmtLiteral_v,
+	StdFunc_ReserveFmtLiteral,
 
 	StdFunc_SimpleMulticastCall,
 
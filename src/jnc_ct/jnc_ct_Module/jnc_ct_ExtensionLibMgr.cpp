@@ -164,6 +164,17 @@ ExtensionLibMgr::loadDynamicLib (const sl::StringRef& fileName)
 	return true;
 }
 
+bool
+ExtensionLibMgr::isStaticLib (ExtensionLib* lib)
+{
+	sl::Iterator <DynamicLibEntry> it = m_dynamicLibList.getHead ();
+	for (; it; it++)
+		if (it->m_lib == lib)
+			return false;
+
+	return true;
+}
+
 bool
 ExtensionLibMgr::mapAddresses ()
 {
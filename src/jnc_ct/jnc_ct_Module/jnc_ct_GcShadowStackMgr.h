@@ -100,6 +100,13 @@ public:
 		ASSERT (m_mapKind == GcShadowStackFrameMapKind_Dynamic);
 		m_gcRootArray.append ((intptr_t) box);
 	}
+
+	void
+	clearBoxes ()
+	{
+		ASSERT (m_mapKind == GcShadowStackFrameMapKind_Dynamic);
+		m_gcRootArray.clear ();
+	}
 };
 
 //..............................................................................
@@ -47,6 +47,20 @@ JitMemoryMgr::getSymbolAddress (const std::string &name)
 	return 0;
 }
 
+#if (LLVM_VERSION >= 0x0305)
+uint8_t*
+JitMemoryMgr::allocateCodeSection (
+	uintptr_t size,
+	unsigned alignment,
+	unsigned sectionId,
+	llvm::StringRef sectionName
+	)
+{
+	m_module->addMachineCodeSize (size);
+	return llvm::SectionMemoryManager::allocateCodeSection (size, alignment, sectionId, sectionName);
+}
+#endif
+
 //..............................................................................
 
 } // namespace ct
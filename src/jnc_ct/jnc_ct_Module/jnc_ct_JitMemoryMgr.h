@@ -42,6 +42,17 @@ public:
 	virtual
 	uint64_t
 	getSymbolAddress (const std::string &name);
+
+#if (LLVM_VERSION >= 0x0305)
+	virtual
+	uint8_t*
+	allocateCodeSection (
+		uintptr_t size,
+		unsigned alignment,
+		unsigned sectionId,
+		llvm::StringRef sectionName
+		);
+#endif
 };
 
 //..............................................................................
@@ -12,6 +12,7 @@
 #include "pch.h"
 #include "jnc_ct_Module.h"
 #include "jnc_ct_JitMemoryMgr.h"
+#include "jnc_ct_TokenCache.h"
 #include "jnc_ct_Parser.llk.h"
 
 namespace jnc {
@@ -37,16 +38,41 @@ namespace ct {
 
 //..............................................................................
 
+uint64_t
+getThreadCpuTime ()
+{
+#if (_JNC_OS_WIN)
+	FILETIME creationTime;
+	FILETIME exitTime;
+	FILETIME kernelTime;
+	FILETIME userTime;
+
+	::GetThreadTimes (::GetCurrentThread (), &creationTime, &exitTime, &kernelTime, &userTime);
+
+	return
+		((uint64_t) kernelTime.dwHighDateTime << 32 | kernelTime.dwLowDateTime) +
+		((uint64_t) userTime.dwHighDateTime << 32 | userTime.dwLowDateTime);
+#else
+	timespec ts;
+	clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+	return (uint64_t) ts.tv_sec * 10000000 + ts.tv_nsec / 100;
+#endif
+}
+
+//..............................................................................
+
 Module::Module ()
 {
 	m_compileFlags = ModuleCompileFlag_StdFlags;
 	m_compileState = ModuleCompileState_Idle;
+	memset (&m_compileStats, 0, sizeof (m_compileStats));
 
 	m_llvmContext = NULL;
 	m_llvmModule = NULL;
 	m_llvmExecutionEngine = NULL;
 	m_constructor = NULL;
 	m_destructor = NULL;
+	m_runtimeAttachFlag = 0;
 
 	finalizeConstruction ();
 }
@@ -63,17 +89,20 @@ Module::clear ()
 	m_operatorMgr.clear ();
 	m_gcShadowStackMgr.clear ();
 	m_regexMgr.clear ();
+	m_variantMemberCache.clear ();
 	m_unitMgr.clear ();
 	m_importMgr.clear ();
 	m_extensionLibMgr.clear ();
 	m_doxyMgr.clear ();
 
 	m_name.clear ();
+	m_jitCpu.clear ();
+	m_jitCpuFeatures.clear ();
 	m_llvmIrBuilder.clear ();
 	m_llvmDiBuilder.clear ();
 	m_calcLayoutArray.clear ();
 	m_compileArray.clear ();
-	m_sourceList.clear ();
+	m_sourceFileList.clear ();
 	m_filePathSet.clear ();
 	m_functionMap.clear ();
 
@@ -93,6 +122,7 @@ Module::clear ()
 
 	m_compileFlags = ModuleCompileFlag_StdFlags;
 	m_compileState = ModuleCompileState_Idle;
+	memset (&m_compileStats, 0, sizeof (m_compileStats));
 }
 
 void
@@ -292,11 +322,53 @@ Module::createLlvmExecutionEngine ()
 	}
 
 	engineBuilder.setTargetOptions (targetOptions);
+	engineBuilder.setOptLevel (
+		(m_compileFlags & ModuleCompileFlag_Optimize) ?
+			llvm::CodeGenOpt::Aggressive :
+			llvm::CodeGenOpt::Default
+		);
 
 #if (_JNC_CPU_X86)
 	engineBuilder.setMArch ("x86");
 #endif
 
+	// an explicitly named CPU takes precedence over the host CPU
+	// (for reproducible code generation across machines)
+
+	llvm::SmallVector <std::string, 32> cpuFeatureArray;
+
+	if (!m_jitCpu.isEmpty () || !m_jitCpuFeatures.isEmpty ())
+	{
+		if (!m_jitCpu.isEmpty ())
+			engineBuilder.setMCPU (m_jitCpu.sz ());
+
+		const char* p = m_jitCpuFeatures.sz ();
+		const char* end = p + m_jitCpuFeatures.getLength ();
+		while (p < end)
+		{
+			const char* comma = (const char*) memchr (p, ',', end - p);
+			const char* next = comma ? comma : end;
+			if (next > p)
+				cpuFeatureArray.push_back (std::string (p, next - p));
+
+			p = next + 1;
+		}
+	}
+	else if (m_compileFlags & ModuleCompileFlag_HostCpu)
+	{
+		engineBuilder.setMCPU (llvm::sys::getHostCPUName ());
+
+		llvm::StringMap <bool> hostFeatureMap;
+		llvm::sys::getHostCPUFeatures (hostFeatureMap);
+
+		llvm::StringMap <bool>::iterator it = hostFeatureMap.begin ();
+		for (; it != hostFeatureMap.end (); it++)
+			cpuFeatureArray.push_back ((it->second ? "+" : "-") + it->first ().str ());
+	}
+
+	if (!cpuFeatureArray.empty ())
+		engineBuilder.setMAttrs (cpuFeatureArray);
+
 	sys::ScopedTlsPtrSlot <Module> scopeModule (this); // for GcShadowStack
 
 	m_llvmExecutionEngine = engineBuilder.create ();
@@ -470,6 +542,61 @@ Module::markForCompile (ModuleItem* item)
 	m_compileArray.append (item);
 }
 
+static
+bool
+parseToken (
+	Parser* parser,
+	uint_t compileFlags,
+	const sl::StringRef& fileName,
+	const Token* token
+	)
+{
+	bool result;
+
+	switch (token->m_token)
+	{
+	case TokenKind_Error:
+		err::setFormatStringError ("invalid character '\\x%02x'", (uchar_t) token->m_data.m_integer);
+		lex::pushSrcPosError (fileName, token->m_pos);
+		return false;
+
+	case TokenKind_DoxyComment1:
+	case TokenKind_DoxyComment2:
+	case TokenKind_DoxyComment3:
+	case TokenKind_DoxyComment4:
+		if (!(compileFlags & (ModuleCompileFlag_DisableDoxyComment1 << (token->m_token - TokenKind_DoxyComment1))))
+		{
+			sl::StringRef comment = token->m_data.m_string;
+			bool isSingleLine = token->m_token <= TokenKind_DoxyComment2;
+			ModuleItem* lastDeclaredItem = NULL;
+
+			if (isSingleLine && !comment.isEmpty () && comment [0] == '<')
+			{
+				lastDeclaredItem = parser->m_lastDeclaredItem;
+				comment = comment.getSubString (1);
+			}
+
+			parser->m_doxyParser.addComment (
+				comment,
+				token->m_pos,
+				isSingleLine,
+				lastDeclaredItem
+				);
+		}
+		break;
+
+	default:
+		result = parser->parseToken (token);
+		if (!result)
+		{
+			lex::ensureSrcPosError (fileName, token->m_pos);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 bool
 Module::parse (
 	ExtensionLib* lib,
@@ -477,68 +604,70 @@ Module::parse (
 	const sl::StringRef& source
 	)
 {
-	bool result;
+	// sources of static libs never change -- re-use tokens lexed by previous modules
 
-	Unit* unit = m_unitMgr.createUnit (lib, fileName);
-	m_unitMgr.setCurrentUnit (unit);
+	const sl::BoxList <Token>* tokenList =
+		lib &&
+		!(m_compileFlags & ModuleCompileFlag_Documentation) &&
+		m_extensionLibMgr.isStaticLib (lib) ?
+			getTokenCache ()->getTokenList (fileName, source) :
+			NULL;
 
-	Lexer lexer;
-	lexer.create (fileName, source);
+	return parseImpl (lib, fileName, source, tokenList);
+}
 
-	if (m_compileFlags & ModuleCompileFlag_Documentation)
-		lexer.m_channelMask = TokenChannelMask_All; // also include doxy-comments
+bool
+Module::parseImpl (
+	ExtensionLib* lib,
+	const sl::StringRef& fileName,
+	const sl::StringRef& source,
+	const sl::BoxList <Token>* tokenList
+	)
+{
+	bool result;
+
+	CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_Parse]);
+
+	Unit* unit = m_unitMgr.createUnit (lib, fileName, source);
+	m_unitMgr.setCurrentUnit (unit);
 
 	Parser parser (this);
 	parser.create (Parser::StartSymbol, true);
 
-	for (;;)
+	if (tokenList)
 	{
-		const Token* token = lexer.getToken ();
-		switch (token->m_token)
+		sl::ConstBoxIterator <Token> it = tokenList->getHead ();
+		for (; it; it++)
 		{
-		case TokenKind_Error:
-			err::setFormatStringError ("invalid character '\\x%02x'", (uchar_t) token->m_data.m_integer);
-			lex::pushSrcPosError (fileName, token->m_pos);
-			return false;
-
-		case TokenKind_DoxyComment1:
-		case TokenKind_DoxyComment2:
-		case TokenKind_DoxyComment3:
-		case TokenKind_DoxyComment4:
-			if (!(m_compileFlags & (ModuleCompileFlag_DisableDoxyComment1 << (token->m_token - TokenKind_DoxyComment1))))
-			{
-				sl::StringRef comment = token->m_data.m_string;
-				bool isSingleLine = token->m_token <= TokenKind_DoxyComment2;
-				ModuleItem* lastDeclaredItem = NULL;
-
-				if (isSingleLine && !comment.isEmpty () && comment [0] == '<')
-				{
-					lastDeclaredItem = parser.m_lastDeclaredItem;
-					comment = comment.getSubString (1);
-				}
-
-				parser.m_doxyParser.addComment (
-					comment,
-					token->m_pos,
-					isSingleLine,
-					lastDeclaredItem
-					);
-			}
-			break;
+			m_compileStats.m_tokenCount++;
 
-		default:
-			result = parser.parseToken (token);
+			result = parseToken (&parser, m_compileFlags, fileName, &*it);
 			if (!result)
-			{
-				lex::ensureSrcPosError (fileName, token->m_pos);
 				return false;
-			}
 		}
+	}
+	else
+	{
+		Lexer lexer;
+		lexer.create (fileName, source);
 
-		if (token->m_token == TokenKind_Eof) // EOF token must be parsed
-			break;
+		if (m_compileFlags & ModuleCompileFlag_Documentation)
+			lexer.m_channelMask = TokenChannelMask_All; // also include doxy-comments
 
-		lexer.nextToken ();
+		for (;;)
+		{
+			const Token* token = lexer.getToken ();
+			m_compileStats.m_tokenCount++;
+
+			result = parseToken (&parser, m_compileFlags, fileName, token);
+			if (!result)
+				return false;
+
+			if (token->m_token == TokenKind_Eof) // EOF token must be parsed
+				break;
+
+			lexer.nextToken ();
+		}
 	}
 
 	m_namespaceMgr.getGlobalNamespace ()->getUsingSet ()->clear ();
@@ -555,35 +684,273 @@ Module::parseFile (const sl::StringRef& fileName)
 	if (it)
 		return true; // already parsed
 
-	io::SimpleMappedFile file;
-	bool result = file.open (filePath, io::FileFlag_ReadOnly);
+	MappedSourceFile* sourceFile = AXL_MEM_NEW (MappedSourceFile);
+
+	bool result = sourceFile->m_file.open (filePath, io::FileFlag_ReadOnly);
 	if (!result)
+	{
+		AXL_MEM_DELETE (sourceFile);
 		return false;
+	}
 
-	size_t length = file.getMappingSize ();
-	sl::String source ((const char*) file.p (), length);
+	m_sourceFileList.insertTail (sourceFile);
+
+	size_t length = sourceFile->m_file.getMappingSize ();
+	sl::StringRef source ((const char*) sourceFile->m_file.p (), length);
 
-	m_sourceList.insertTail (source);
 	m_filePathSet.visit (filePath);
 
 	return parse (NULL, filePath, source);
 }
 
+//..............................................................................
+
+// worker side of parallel lexing of imports -- touches nothing but LexedSourceFile
+
+struct ImportLexerContext
+{
+	LexedSourceFile* const* m_fileArray;
+	size_t m_fileCount;
+	volatile size_t m_nextFileIdx;
+	bool m_isDocumentation;
+};
+
+static
+void
+lexSourceFile (
+	LexedSourceFile* file,
+	bool isDocumentation
+	)
+{
+	MappedSourceFile* sourceFile = AXL_MEM_NEW (MappedSourceFile);
+
+	bool result = sourceFile->m_file.open (file->m_filePath, io::FileFlag_ReadOnly);
+	if (!result)
+	{
+		file->m_error = err::getLastError ();
+		AXL_MEM_DELETE (sourceFile);
+		return;
+	}
+
+	file->m_sourceFile = sourceFile;
+
+	size_t length = sourceFile->m_file.getMappingSize ();
+	sl::StringRef source ((const char*) sourceFile->m_file.p (), length);
+
+	Lexer lexer;
+	lexer.create (file->m_filePath, source);
+
+	if (isDocumentation)
+		lexer.m_channelMask = TokenChannelMask_All; // also include doxy-comments
+
+	for (;;)
+	{
+		const Token* token = lexer.getToken ();
+		file->m_tokenList.insertTail (*token);
+
+		if (token->m_token == TokenKind_Eof || token->m_token == TokenKind_Error)
+			break;
+
+		lexer.nextToken ();
+	}
+}
+
+static
+void
+lexSourceFiles (ImportLexerContext* context)
+{
+	for (;;)
+	{
+		size_t i = sys::atomicInc (&context->m_nextFileIdx) - 1;
+		if (i >= context->m_fileCount)
+			break;
+
+		lexSourceFile (context->m_fileArray [i], context->m_isDocumentation);
+	}
+}
+
+class ImportLexerThread: public sys::ThreadImpl <ImportLexerThread>
+{
+public:
+	ImportLexerContext* m_context;
+	uint64_t m_cpuTime;
+
+public:
+	void
+	threadFunc ()
+	{
+		uint64_t cpuTime = getThreadCpuTime ();
+		lexSourceFiles (m_context);
+		m_cpuTime = getThreadCpuTime () - cpuTime;
+	}
+};
+
+//..............................................................................
+
+void
+Module::lexImportFiles (
+	sl::ConstIterator <Import> importIt,
+	sl::List <LexedSourceFile>* fileList,
+	sl::StringHashTable <LexedSourceFile*>* fileMap
+	)
+{
+	// lexing is a part of parsing in the time report; the timer only sees
+	// the calling thread, so the CPU time of workers is added separately
+
+	ModuleCompilePhaseTime* phaseTime = &m_compileStats.m_phaseTimeTable [ModuleCompilePhase_Parse];
+	CompilePhaseTimer timer (phaseTime);
+
+	sl::Array <LexedSourceFile*> fileArray;
+
+	for (; importIt; importIt++)
+	{
+		if (importIt->m_importKind != ImportKind_File)
+			continue;
+
+		sl::String filePath = io::getFullFilePath (importIt->m_filePath);
+		if (m_filePathSet.find (filePath))
+			continue;
+
+		sl::StringHashTableIterator <LexedSourceFile*> it = fileMap->visit (filePath);
+		if (it->m_value)
+			continue;
+
+		LexedSourceFile* file = AXL_MEM_NEW (LexedSourceFile);
+		file->m_filePath = filePath;
+		fileList->insertTail (file);
+		fileArray.append (file);
+		it->m_value = file;
+	}
+
+	ImportLexerContext context;
+	context.m_fileArray = fileArray.cp ();
+	context.m_fileCount = fileArray.getCount ();
+	context.m_nextFileIdx = 0;
+	context.m_isDocumentation = (m_compileFlags & ModuleCompileFlag_Documentation) != 0;
+
+	// the calling thread is a lexer, too
+
+	size_t threadCount = AXL_MIN (
+		g::getModule ()->getSystemInfo ()->m_processorCount,
+		context.m_fileCount
+		);
+
+	sl::AutoPtrArray <ImportLexerThread> threadArray;
+
+	for (size_t i = 1; i < threadCount; i++)
+	{
+		ImportLexerThread* thread = AXL_MEM_NEW (ImportLexerThread);
+		thread->m_context = &context;
+		thread->m_cpuTime = 0;
+
+		bool result = thread->start ();
+		if (!result)
+		{
+			AXL_MEM_DELETE (thread);
+			break; // fine, fewer lexers
+		}
+
+		threadArray.append (thread);
+	}
+
+	lexSourceFiles (&context);
+
+	size_t count = threadArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+	{
+		threadArray [i]->waitAndClose ();
+		phaseTime->m_cpuTime += threadArray [i]->m_cpuTime;
+	}
+}
+
+bool
+Module::parseLexedFile (LexedSourceFile* file)
+{
+	if (!file->m_sourceFile)
+	{
+		err::setError (file->m_error);
+		return false;
+	}
+
+	m_sourceFileList.insertTail (file->m_sourceFile); // mapping must outlive compilation
+	file->m_sourceFile = NULL;
+
+	m_filePathSet.visit (file->m_filePath);
+
+	size_t length = m_sourceFileList.getTail ()->m_file.getMappingSize ();
+	sl::StringRef source ((const char*) m_sourceFileList.getTail ()->m_file.p (), length);
+
+	bool result = parseImpl (NULL, file->m_filePath, source, &file->m_tokenList);
+	file->m_tokenList.clear (); // no longer needed
+	return result;
+}
+
+bool
+Module::isSourceModified (
+	const sl::StringRef& fileName,
+	const sl::StringRef& source
+	)
+{
+	Unit* unit = m_unitMgr.findUnit (fileName);
+	return !unit || !unit->isSourceMatch (source);
+}
+
+bool
+Module::isFileModified (const sl::StringRef& fileName)
+{
+	sl::String filePath = io::getFullFilePath (fileName);
+
+	io::SimpleMappedFile file;
+	bool result = file.open (filePath, io::FileFlag_ReadOnly);
+	if (!result)
+		return true; // vanished or inaccessible files are treated as modified
+
+	size_t length = file.getMappingSize ();
+	return isSourceModified (filePath, sl::StringRef ((const char*) file.p (), length));
+}
+
 bool
 Module::parseImports ()
 {
 	sl::ConstList <Import> importList = m_importMgr.getImportList ();
 	sl::ConstIterator <Import> importIt = importList.getHead ();
 
+	// files are lexed in batches ahead of parsing; parsing itself stays serial
+	// and in import order, so the result doesn't depend on thread timing
+
+	sl::List <LexedSourceFile> lexedFileList;
+	sl::StringHashTable <LexedSourceFile*> lexedFileMap;
+
 	for (; importIt; importIt++)
 	{
-		bool result = importIt->m_importKind == ImportKind_Source ?
-			parse (
+		bool result;
+
+		if (importIt->m_importKind == ImportKind_Source)
+		{
+			result = parse (
 				importIt->m_lib,
 				importIt->m_filePath,
 				importIt->m_source
-				) :
-			parseFile (importIt->m_filePath);
+				);
+		}
+		else
+		{
+			sl::String filePath = io::getFullFilePath (importIt->m_filePath);
+			if (m_filePathSet.find (filePath))
+				continue; // already parsed
+
+			sl::StringHashTableIterator <LexedSourceFile*> it = lexedFileMap.find (filePath);
+			if (!it)
+			{
+				// lex this one and everything imported so far
+
+				lexImportFiles (importIt, &lexedFileList, &lexedFileMap);
+				it = lexedFileMap.find (filePath);
+				ASSERT (it);
+			}
+
+			result = parseLexedFile (it->m_value);
+		}
 
 		if (!result)
 			return false;
@@ -599,6 +966,8 @@ Module::link ()
 
 	ASSERT (m_compileState < ModuleCompileState_Linked);
 
+	CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_Link]);
+
 	result =
 		m_typeMgr.resolveImportTypes () &&
 		m_namespaceMgr.resolveImportUsingSets () &&
@@ -624,6 +993,8 @@ Module::calcLayout ()
 			return false;
 	}
 
+	CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_CalcLayout]);
+
 	result = processCalcLayoutArray ();
 	if (!result)
 		return false;
@@ -645,30 +1016,75 @@ Module::compile ()
 			return false;
 	}
 
-	result = createConstructorDestructor ();
-	if (!result)
-		return false;
+	{
+		CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_CompileFunctions]);
+
+		result = createConstructorDestructor ();
+		if (!result)
+			return false;
 
-	// compile the rest
+		// compile the rest
 
-	result = processCompileArray ();
-	if (!result)
-		return false;
+		result = processCompileArray ();
+		if (!result)
+			return false;
+
+		// now that all the overrides are known
+
+		m_operatorMgr.devirtualizeCalls ();
+		m_operatorMgr.injectClosureCacheReset ();
+	}
 
 	// deal with tls
 
-	result =
-		m_variableMgr.createTlsStructType () &&
-		m_functionMgr.injectTlsPrologues ();
+	{
+		CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_InjectTlsPrologues]);
 
-	if (!result)
-		return false;
+		result =
+			m_variableMgr.createTlsStructType () &&
+			m_functionMgr.injectTlsPrologues ();
+
+		if (!result)
+			return false;
+	}
 
 	// delete unreachable blocks
 
-	result = m_controlFlowMgr.deleteUnreachableBlocks ();
-	if (!result)
-		return false;
+	{
+		CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_DeleteUnreachableBlocks]);
+
+		result = m_controlFlowMgr.deleteUnreachableBlocks ();
+		if (!result)
+			return false;
+	}
+
+	// drop library functions nothing refers to (if requested)
+
+	if ((m_compileFlags & ModuleCompileFlag_StripUnusedLibFunctions) && !(m_compileFlags & ModuleCompileFlag_DebugInfo))
+		m_compileStats.m_strippedFunctionCount += m_functionMgr.stripUnusedLibFunctions ();
+
+	// run the optimized tier over functions with loops (if requested), then
+	// hoist and merge inline range checks in the rest (setjmp-free functions only)
+
+	if (!(m_compileFlags & ModuleCompileFlag_DebugInfo))
+	{
+		CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_Optimize]);
+
+		if (m_compileFlags & ModuleCompileFlag_Optimize)
+			m_functionMgr.optimizeHotFunctions ();
+
+		m_functionMgr.optimizeRangeChecks ();
+
+		if (m_compileFlags & ModuleCompileFlag_Optimize)
+			m_functionMgr.optimizeInternalCalls ();
+	}
+
+	m_compileStats.m_functionCount =
+		m_functionMgr.getFunctionList ().getCount () +
+		m_functionMgr.getThunkFunctionList ().getCount ();
+
+	m_compileStats.m_typeCount = m_typeMgr.getTypeCount ();
+	m_compileStats.m_llvmInstructionCount = getLlvmInstructionCount ();
 
 	// finalize debug information
 
@@ -692,11 +1108,19 @@ Module::jit ()
 			return false;
 	}
 
+	CompilePhaseTimer timer (&m_compileStats.m_phaseTimeTable [ModuleCompilePhase_Jit]);
+
 	result =
 		createLlvmExecutionEngine () &&
-		m_extensionLibMgr.mapAddresses () &&
-		m_functionMgr.jitFunctions ();
+		m_extensionLibMgr.mapAddresses ();
+
+	if (!result)
+		return false;
 
+	if ((m_compileFlags & ModuleCompileFlag_Optimize) && !(m_compileFlags & ModuleCompileFlag_DebugInfo))
+		m_functionMgr.vectorizeHotFunctions ();
+
+	result = m_functionMgr.jitFunctions ();
 	if (!result)
 		return false;
 
@@ -704,6 +1128,33 @@ Module::jit ()
 	return true;
 }
 
+size_t
+Module::finalizeForRuntime ()
+{
+	// once jitted, a module only needs machine code, type layouts and
+	// reflection data; source mappings are kept as initializer tokens of
+	// reflected items still point into them (and these pages are clean anyway)
+
+	ASSERT (m_compileState == ModuleCompileState_Jitted);
+	if (m_compileState != ModuleCompileState_Jitted)
+		return 0;
+
+	size_t size = m_functionMgr.freeFunctionBodies ();
+
+	// the legacy JIT may still need IR to resolve lazy stubs
+
+	if (m_compileFlags & ModuleCompileFlag_McJit)
+		size += m_functionMgr.freeLlvmFunctionBodies ();
+
+	if (!(m_compileFlags & ModuleCompileFlag_Documentation))
+		size += m_doxyMgr.freeBlockText ();
+
+	m_llvmIrBuilder.clear ();
+	m_llvmDiBuilder.clear ();
+
+	return size;
+}
+
 bool
 Module::processCalcLayoutArray ()
 {
@@ -839,6 +1290,22 @@ Module::createConstructorDestructor ()
 	return true;
 }
 
+size_t
+Module::getLlvmInstructionCount ()
+{
+	size_t count = 0;
+
+	llvm::Module::iterator functionIt = m_llvmModule->begin ();
+	for (; functionIt != m_llvmModule->end (); functionIt++)
+	{
+		llvm::Function::iterator blockIt = functionIt->begin ();
+		for (; blockIt != functionIt->end (); blockIt++)
+			count += blockIt->size ();
+	}
+
+	return count;
+}
+
 sl::String
 Module::getLlvmIrString ()
 {
@@ -21,6 +21,7 @@
 #include "jnc_ct_OperatorMgr.h"
 #include "jnc_ct_GcShadowStackMgr.h"
 #include "jnc_ct_RegexMgr.h"
+#include "jnc_ct_VariantMemberCache.h"
 #include "jnc_ct_UnitMgr.h"
 #include "jnc_ct_LlvmIrBuilder.h"
 #include "jnc_ct_LlvmDiBuilder.h"
@@ -62,6 +63,70 @@ protected:
 
 //..............................................................................
 
+// in 100-nanosecond intervals (same as sys::getTimestamp)
+
+uint64_t
+getThreadCpuTime ();
+
+// . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+// cheap enough to be always on: two timer reads per phase
+
+class CompilePhaseTimer
+{
+protected:
+	ModuleCompilePhaseTime* m_phaseTime;
+	uint64_t m_wallTime;
+	uint64_t m_cpuTime;
+
+public:
+	CompilePhaseTimer (ModuleCompilePhaseTime* phaseTime)
+	{
+		m_phaseTime = phaseTime;
+		m_wallTime = sys::getPreciseTimestamp ();
+		m_cpuTime = getThreadCpuTime ();
+	}
+
+	~CompilePhaseTimer ()
+	{
+		m_phaseTime->m_wallTime += sys::getPreciseTimestamp () - m_wallTime;
+		m_phaseTime->m_cpuTime += getThreadCpuTime () - m_cpuTime;
+	}
+};
+
+//..............................................................................
+
+// source files are parsed directly from their mappings (no copying);
+// mappings must stay alive during compilation as tokens point into them
+
+struct MappedSourceFile: sl::ListLink
+{
+	io::SimpleMappedFile m_file;
+};
+
+// imported files are mapped and lexed on worker threads ahead of parsing
+
+struct LexedSourceFile: sl::ListLink
+{
+	sl::String m_filePath;
+	MappedSourceFile* m_sourceFile; // NULL if the file could not be opened
+	err::Error m_error;
+	sl::BoxList <Token> m_tokenList;
+
+	LexedSourceFile ()
+	{
+		m_sourceFile = NULL;
+	}
+
+	~LexedSourceFile ()
+	{
+		if (m_sourceFile)
+			AXL_MEM_DELETE (m_sourceFile);
+	}
+};
+
+//..............................................................................
+
 class Module: public PreModule
 {
 protected:
@@ -69,13 +134,21 @@ protected:
 
 	uint_t m_compileFlags;
 	ModuleCompileState m_compileState;
+	sl::String m_jitCpu;
+	sl::String m_jitCpuFeatures;
+
+	// global variables, static GC roots and static destructors live in the
+	// JIT-ed module image, so only one runtime at a time may run a module
+
+	volatile int32_t m_runtimeAttachFlag;
+	ModuleCompileStats m_compileStats;
 
 	Function* m_constructor;
 	Function* m_destructor;
 
 	sl::Array <ModuleItem*> m_calcLayoutArray;
 	sl::Array <ModuleItem*> m_compileArray;
-	sl::BoxList <sl::String> m_sourceList; // need to keep all sources in-memory during compilation
+	sl::List <MappedSourceFile> m_sourceFileList; // need to keep all sources in-memory during compilation
 	sl::StringHashTable <bool> m_filePathSet;
 	sl::StringHashTable <void*> m_functionMap;
 
@@ -94,6 +167,7 @@ public:
 	OperatorMgr m_operatorMgr;
 	GcShadowStackMgr m_gcShadowStackMgr;
 	RegexMgr m_regexMgr;
+	VariantMemberCache m_variantMemberCache;
 	UnitMgr m_unitMgr;
 	ImportMgr m_importMgr;
 	ExtensionLibMgr m_extensionLibMgr;
@@ -121,12 +195,58 @@ public:
 		return m_compileFlags;
 	}
 
+	bool
+	attachRuntime ()
+	{
+		return sys::atomicCmpXchg (&m_runtimeAttachFlag, 0, 1) == 0;
+	}
+
+	void
+	detachRuntime ()
+	{
+		sys::atomicXchg (&m_runtimeAttachFlag, 0);
+	}
+
+	void
+	setJitCpu (
+		const sl::StringRef& cpu,
+		const sl::StringRef& features
+		)
+	{
+		m_jitCpu = cpu;
+		m_jitCpuFeatures = features;
+	}
+
 	ModuleCompileState
 	getCompileState ()
 	{
 		return m_compileState;
 	}
 
+	const ModuleCompileStats&
+	getCompileStats ()
+	{
+		return m_compileStats;
+	}
+
+	void
+	addMachineCodeSize (size_t size)
+	{
+		m_compileStats.m_machineCodeSize += size;
+	}
+
+	void
+	addWidenedRangeCheckCount (size_t count)
+	{
+		m_compileStats.m_widenedRangeCheckCount += count;
+	}
+
+	void
+	addOptimizedFunctionCount (size_t count)
+	{
+		m_compileStats.m_optimizedFunctionCount += count;
+	}
+
 	llvm::LLVMContext*
 	getLlvmContext ()
 	{
@@ -225,6 +345,17 @@ public:
 	bool
 	parseImports ();
 
+	// hot-reload support: compare against the source hash of the latest unit with this path
+
+	bool
+	isSourceModified (
+		const sl::StringRef& fileName,
+		const sl::StringRef& source
+		);
+
+	bool
+	isFileModified (const sl::StringRef& fileName);
+
 	bool
 	link ();
 
@@ -237,6 +368,9 @@ public:
 	bool
 	jit ();
 
+	size_t
+	finalizeForRuntime (); // returns the approximate number of bytes freed
+
 	bool
 	postParseStdItem ();
 
@@ -259,6 +393,24 @@ public:
 	getLlvmIrString ();
 
 protected:
+	bool
+	parseImpl (
+		ExtensionLib* lib,
+		const sl::StringRef& fileName,
+		const sl::StringRef& source,
+		const sl::BoxList <Token>* tokenList // NULL means lex on the fly
+		);
+
+	bool
+	parseLexedFile (LexedSourceFile* file);
+
+	void
+	lexImportFiles (
+		sl::ConstIterator <Import> importIt,
+		sl::List <LexedSourceFile>* fileList,
+		sl::StringHashTable <LexedSourceFile*>* fileMap
+		);
+
 	bool
 	createLlvmExecutionEngine ();
 
@@ -270,6 +422,9 @@ protected:
 
 	bool
 	processCompileArray ();
+
+	size_t
+	getLlvmInstructionCount ();
 };
 
 //..............................................................................
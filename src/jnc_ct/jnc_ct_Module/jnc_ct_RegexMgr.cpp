@@ -24,6 +24,7 @@ Dfa::Dfa ()
 	m_stateCount = 0;
 	m_groupCount = 0;
 	m_maxSubMatchCount = 0;
+	m_charClassCount = 0;
 }
 
 void
@@ -32,6 +33,7 @@ Dfa::clear ()
 	m_stateCount = 0;
 	m_groupCount = 0;
 	m_maxSubMatchCount = 0;
+	m_charClassCount = 0;
 	m_transitionTable.clear ();
 	m_stateInfoTable.clear ();
 	m_acceptInfoList.clear ();
@@ -46,13 +48,15 @@ Dfa::build (fsm::Regex* regex)
 	m_groupCount = regex->getGroupCount ();
 	m_maxSubMatchCount = 0;
 
+	sl::Array <uintptr_t> fullTransitionTable;
+	fullTransitionTable.setCount (m_stateCount * 256);
+
 	m_stateInfoTable.setCount (m_stateCount);
-	m_transitionTable.setCount (m_stateCount * 256);
 	memset (m_stateInfoTable, 0, m_stateCount * sizeof (DfaStateInfo));
-	memset (m_transitionTable, -1, m_stateCount * 256 * sizeof (uintptr_t));
+	memset (fullTransitionTable, -1, m_stateCount * 256 * sizeof (uintptr_t));
 
 	DfaStateInfo* stateInfo = m_stateInfoTable;
-	uintptr_t* transitionRow = m_transitionTable;
+	uintptr_t* transitionRow = fullTransitionTable;
 
 	for (size_t i = 0; i < m_stateCount; i++)
 	{
@@ -130,9 +134,58 @@ Dfa::build (fsm::Regex* regex)
 		transitionRow += 256;
 	}
 
+	buildCharClassTable (fullTransitionTable);
 	return true;
 }
 
+void
+Dfa::buildCharClassTable (const uintptr_t* fullTransitionTable)
+{
+	// bytes with identical transition columns are merged into a single class;
+	// tokenizers rarely need more than a few dozen classes, so the resulting
+	// table is many times smaller than the full one and stays in cache
+
+	uchar_t classCharTable [256]; // representative char of each class
+
+	m_charClassCount = 0;
+
+	for (size_t c = 0; c < 256; c++)
+	{
+		size_t k = 0;
+		for (; k < m_charClassCount; k++)
+		{
+			size_t c2 = classCharTable [k];
+			size_t i = 0;
+
+			for (; i < m_stateCount; i++)
+				if (fullTransitionTable [i * 256 + c] != fullTransitionTable [i * 256 + c2])
+					break;
+
+			if (i == m_stateCount) // identical columns
+				break;
+		}
+
+		if (k == m_charClassCount)
+			classCharTable [m_charClassCount++] = (uchar_t) c;
+
+		m_charClassTable [c] = (uchar_t) k;
+	}
+
+	m_transitionTable.setCount (m_stateCount * m_charClassCount);
+
+	uintptr_t* transitionRow = m_transitionTable;
+	const uintptr_t* fullTransitionRow = fullTransitionTable;
+
+	for (size_t i = 0; i < m_stateCount; i++)
+	{
+		for (size_t k = 0; k < m_charClassCount; k++)
+			transitionRow [k] = fullTransitionRow [classCharTable [k]];
+
+		transitionRow += m_charClassCount;
+		fullTransitionRow += 256;
+	}
+}
+
 //..............................................................................
 
 RegexMgr::RegexMgr ()
@@ -64,7 +64,9 @@ protected:
 	size_t m_stateCount;
 	size_t m_groupCount;
 	size_t m_maxSubMatchCount;
-	sl::Array <uintptr_t> m_transitionTable;
+	size_t m_charClassCount;
+	uchar_t m_charClassTable [256];
+	sl::Array <uintptr_t> m_transitionTable; // m_stateCount x m_charClassCount
 	sl::Array <DfaStateInfo> m_stateInfoTable;
 	sl::List <DfaAcceptInfo> m_acceptInfoList;
 	sl::List <DfaGroupSet> m_groupSetList;
@@ -96,6 +98,12 @@ public:
 		return m_maxSubMatchCount;
 	}
 
+	size_t
+	getCharClassCount ()
+	{
+		return m_charClassCount;
+	}
+
 	void
 	clear ();
 
@@ -109,7 +117,7 @@ public:
 		)
 	{
 		ASSERT (stateId < m_stateCount);
-		return m_transitionTable [stateId * 256 + c];
+		return m_transitionTable [stateId * m_charClassCount + m_charClassTable [c]];
 	}
 
 	DfaStateInfo*
@@ -117,6 +125,17 @@ public:
 	{
 		return &m_stateInfoTable [stateId];
 	}
+
+	bool
+	isPlainState (uintptr_t stateId) // not accepting, no capture groups
+	{
+		const DfaStateInfo* stateInfo = &m_stateInfoTable [stateId];
+		return !stateInfo->m_flags && !stateInfo->m_groupSet;
+	}
+
+protected:
+	void
+	buildCharClassTable (const uintptr_t* fullTransitionTable);
 };
 
 //.............................................................................
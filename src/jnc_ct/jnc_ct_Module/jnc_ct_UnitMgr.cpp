@@ -22,6 +22,8 @@ Unit::Unit ()
 {
 	m_module = NULL;
 	m_lib = NULL;
+	m_sourceLength = 0;
+	m_sourceHash = 0;
 	m_constructor = NULL;
 	m_destructor = NULL;
 }
@@ -104,10 +106,22 @@ UnitMgr::getCoreLibUnit ()
 	return m_coreLibUnit;
 }
 
+Unit*
+UnitMgr::findUnit (const sl::StringRef& filePath)
+{
+	sl::Iterator <Unit> it = m_unitList.getTail (); // the latest unit wins
+	for (; it; it--)
+		if (it->m_filePath.cmp (filePath) == 0)
+			return *it;
+
+	return NULL;
+}
+
 Unit*
 UnitMgr::createUnit (
 	ExtensionLib* lib,
-	const sl::StringRef& filePath
+	const sl::StringRef& filePath,
+	const sl::StringRef& source
 	)
 {
 	Unit* unit = AXL_MEM_NEW (Unit);
@@ -116,6 +130,8 @@ UnitMgr::createUnit (
 	unit->m_filePath = filePath;
 	unit->m_fileName = io::getFileName (filePath);
 	unit->m_dir = io::getDir  (filePath);
+	unit->m_sourceLength = source.getLength ();
+	unit->m_sourceHash = sl::djb2 (source.cp (), source.getLength ());
 
 	if (m_module->getCompileFlags () & ModuleCompileFlag_DebugInfo)
 		unit->m_llvmDiFile = m_module->m_llvmDiBuilder.createFile (unit->m_fileName, unit->m_dir);
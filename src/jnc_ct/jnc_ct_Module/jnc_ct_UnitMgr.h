@@ -31,6 +31,8 @@ protected:
 	sl::String m_filePath;
 	sl::String m_fileName;
 	sl::String m_dir;
+	size_t m_sourceLength;
+	size_t m_sourceHash;
 
 	llvm::DIFile_vn m_llvmDiFile;
 
@@ -70,6 +72,26 @@ public:
 		return m_dir;
 	}
 
+	size_t
+	getSourceLength () const
+	{
+		return m_sourceLength;
+	}
+
+	size_t
+	getSourceHash () const
+	{
+		return m_sourceHash;
+	}
+
+	bool
+	isSourceMatch (const sl::StringRef& source) const
+	{
+		return
+			m_sourceLength == source.getLength () &&
+			m_sourceHash == sl::djb2 (source.cp (), source.getLength ());
+	}
+
 	llvm::DIFile_vn
 	getLlvmDiFile () const
 	{
@@ -135,10 +157,14 @@ public:
 	Unit*
 	getCoreLibUnit ();
 
+	Unit*
+	findUnit (const sl::StringRef& filePath);
+
 	Unit*
 	createUnit (
 		ExtensionLib* lib,
-		const sl::StringRef& filePath
+		const sl::StringRef& filePath,
+		const sl::StringRef& source = sl::StringRef ()
 		);
 };
 
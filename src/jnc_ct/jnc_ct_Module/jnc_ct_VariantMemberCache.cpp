@@ -0,0 +1,123 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#include "pch.h"
+#include "jnc_ct_VariantMemberCache.h"
+#include "jnc_ct_Module.h"
+
+namespace jnc {
+namespace ct {
+
+//..............................................................................
+
+void
+VariantMemberCache::clear ()
+{
+	for (size_t i = 0; i < EntryCount; i++)
+	{
+		Entry* entry = m_table [i];
+		if (entry)
+		{
+			AXL_MEM_DELETE (entry);
+			m_table [i] = NULL;
+		}
+	}
+}
+
+StructField*
+VariantMemberCache::find (
+	Type* type,
+	const char* name,
+	bool isSetter
+	)
+{
+	size_t idx = getEntryIdx (type, name);
+	for (size_t i = 0; i < ProbeCount; i++, idx = (idx + 1) & (EntryCount - 1))
+	{
+		Entry* entry = m_table [idx];
+		if (!entry)
+			break; // entries are never removed, so the probe sequence ends here
+
+		if (entry->isMatch (type, name, isSetter))
+			return entry->m_field;
+	}
+
+	return NULL;
+}
+
+void
+VariantMemberCache::add (
+	Type* type,
+	const char* name,
+	StructField* field,
+	bool isSetter
+	)
+{
+	Entry* entry = AXL_MEM_NEW (Entry);
+	entry->m_type = type;
+	entry->m_name = name;
+	entry->m_field = field;
+	entry->m_isSetter = isSetter;
+
+	size_t idx = getEntryIdx (type, name);
+	for (size_t i = 0; i < ProbeCount; i++, idx = (idx + 1) & (EntryCount - 1))
+	{
+		Entry* prevEntry = (Entry*) sys::atomicCmpXchg ((size_t volatile*) &m_table [idx], 0, (size_t) entry);
+		if (!prevEntry)
+			return; // published
+
+		if (prevEntry->isMatch (type, name, isSetter))
+			break; // another thread was first
+	}
+
+	// either cached already or the probe sequence is full -- the latter only
+	// means this member keeps taking the generic path
+
+	AXL_MEM_DELETE (entry);
+}
+
+StructField*
+VariantMemberCache::findCacheableField (
+	Type* type,
+	const char* name
+	)
+{
+	// only own scalar fields of classes can be accessed directly: the offset
+	// of those is fixed relative to the interface the class pointer points to
+
+	if (!type ||
+		type->getTypeKind () != TypeKind_ClassPtr ||
+		((ClassPtrType*) type)->getPtrTypeKind () != ClassPtrTypeKind_Normal)
+		return NULL;
+
+	ClassType* classType = ((ClassPtrType*) type)->getTargetType ();
+	if (classType->getFlags () & TypeFlag_Dynamic)
+		return NULL;
+
+	ModuleItem* item = classType->findItem (name);
+	if (!item || item->getItemKind () != ModuleItemKind_StructField)
+		return NULL;
+
+	StructField* field = (StructField*) item;
+	Type* fieldType = field->getType ();
+
+	if (field->getParentNamespace () != classType ||
+		fieldType->getTypeKind () == TypeKind_BitField ||
+		!(fieldType->getTypeKindFlags () & (TypeKindFlag_Integer | TypeKindFlag_Fp)))
+		return NULL;
+
+	return field;
+}
+
+//..............................................................................
+
+} // namespace ct
+} // namespace jnc
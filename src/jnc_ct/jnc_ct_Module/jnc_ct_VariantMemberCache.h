@@ -0,0 +1,114 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#pragma once
+
+namespace jnc {
+namespace ct {
+
+class Type;
+class StructField;
+
+//..............................................................................
+
+// resolved fields of dynamic variant member access, keyed on the dynamic type
+// of the variant and the member name; only actual fields are ever added, so
+// the number of entries is bounded by the fields accessed via variants
+
+// lookups happen on every variant member access from any thread, so the
+// table is lock-free: entries are immutable once published with a cmpxchg
+// into an empty slot, and are only freed by clear (when nothing runs)
+
+class VariantMemberCache
+{
+protected:
+	enum
+	{
+		EntryCount = 256, // must be a power of 2
+		ProbeCount = 8,
+	};
+
+	struct Entry
+	{
+		Type* m_type;
+		sl::String m_name;
+		StructField* m_field;
+		bool m_isSetter;
+
+		bool
+		isMatch (
+			Type* type,
+			const char* name,
+			bool isSetter
+			) const
+		{
+			return m_type == type && m_isSetter == isSetter && m_name.cmp (name) == 0;
+		}
+	};
+
+protected:
+	Entry* volatile m_table [EntryCount];
+
+public:
+	VariantMemberCache ()
+	{
+		memset ((void*) m_table, 0, sizeof (m_table));
+	}
+
+	~VariantMemberCache ()
+	{
+		clear ();
+	}
+
+	void
+	clear ();
+
+	StructField*
+	find (
+		Type* type,
+		const char* name,
+		bool isSetter
+		);
+
+	void
+	add (
+		Type* type,
+		const char* name,
+		StructField* field,
+		bool isSetter
+		);
+
+	static
+	StructField*
+	findCacheableField (
+		Type* type,
+		const char* name
+		);
+
+protected:
+	static
+	size_t
+	getEntryIdx (
+		Type* type,
+		const char* name
+		)
+	{
+		// hash the name contents, not the pointer: names built at runtime
+		// must land on the same slot as the literal they spell
+
+		return (((uintptr_t) type >> 4) ^ sl::djb2 (name, strlen (name))) & (EntryCount - 1);
+	}
+};
+
+//..............................................................................
+
+} // namespace ct
+} // namespace jnc
@@ -157,6 +157,8 @@ void
 OperatorMgr::clear ()
 {
 	m_unsafeEnterCount = 0;
+	m_virtualCallSiteArray.clear ();
+	m_closureCacheVariableArray.clear ();
 }
 
 Function*
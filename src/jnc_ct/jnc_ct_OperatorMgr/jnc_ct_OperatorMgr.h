@@ -44,6 +44,7 @@ namespace jnc {
 namespace ct {
 
 class Module;
+class ClosureClassType;
 
 //..............................................................................
 
@@ -67,6 +68,16 @@ enum OperatorDynamism
 	OperatorDynamism_Dynamic,
 };
 
+// . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+struct VirtualCallSite
+{
+	ClassType* m_classType;
+	size_t m_vtableIndex;
+	llvm::LoadInst* m_llvmVTableLoad;
+	llvm::LoadInst* m_llvmMethodLoad;
+};
+
 //..............................................................................
 
 class OperatorMgr
@@ -183,6 +194,14 @@ protected:
 
 	intptr_t m_unsafeEnterCount;
 
+	// vtable calls to revisit once the class hierarchy is closed
+
+	sl::Array <VirtualCallSite> m_virtualCallSiteArray;
+
+	// static slots of constant-capture closures
+
+	sl::Array <Variable*> m_closureCacheVariableArray;
+
 public:
 	OperatorMgr ();
 
@@ -195,6 +214,12 @@ public:
 	void
 	clear ();
 
+	void
+	devirtualizeCalls ();
+
+	void
+	injectClosureCacheReset ();
+
 	void
 	enterUnsafeRgn ()
 	{
@@ -1552,6 +1577,24 @@ public:
 	void
 	checkNullPtr (const Value& value);
 
+	void
+	checkPtrInline (
+		const Value& failValue,
+		StdFunc stdCheckFunction,
+		StdFunc stdTryCheckFunction,
+		const Value* argValueArray,
+		size_t argCount,
+		BasicBlock* failBlock = NULL
+		);
+
+	void
+	condJumpUnlikely (
+		const Value& value,
+		BasicBlock* thenBlock,
+		BasicBlock* elseBlock,
+		BasicBlock* followBlock = NULL // if NULL then follow with elseBlock
+		);
+
 	// access check
 
 	bool
@@ -1673,6 +1716,29 @@ protected:
 		Value* resultValue
 		);
 
+	Function*
+	findDevirtualizedMethod (
+		ClassType* classType,
+		size_t vtableIndex
+		);
+
+	bool
+	isConstClosure (const Value& opValue);
+
+	bool
+	getCachedClosureObject (
+		const Value& opValue,
+		ClosureClassType* closureType,
+		Value* resultValue
+		);
+
+	bool
+	initClosureObject (
+		const Value& opValue,
+		ClosureClassType* closureType,
+		Value* resultValue
+		);
+
 	bool
 	callImpl (
 		const Value& pfnValue,
@@ -643,8 +643,45 @@ OperatorMgr::gcSafePoint ()
 void
 OperatorMgr::checkStackOverflow ()
 {
+	// compare the frame address against the limit cached in TLS;
+	// only call the runtime (which reports and throws) when it's crossed
+
+	Type* bytePtrType = m_module->m_typeMgr.getStdType (StdType_BytePtr);
+	Variable* stackLimitVariable = m_module->m_variableMgr.getStdVariable (StdVariable_StackLimit);
+
+	llvm::Function* llvmFrameAddress = llvm::Intrinsic::getDeclaration (
+		m_module->getLlvmModule (),
+		llvm::Intrinsic::frameaddress
+		);
+
+	Value frameAddressFunctionValue;
+	frameAddressFunctionValue.setLlvmValue (llvmFrameAddress, NULL);
+
+	Value levelValue;
+	Value frameAddressValue;
+	Value stackLimitValue;
+	Value cmpValue;
+
+	levelValue.setConstInt32 (0, m_module->m_typeMgr.getPrimitiveType (TypeKind_Int32));
+
+	m_module->m_llvmIrBuilder.createCall (
+		frameAddressFunctionValue,
+		m_module->m_typeMgr.getCallConv (CallConvKind_Default),
+		&levelValue, 1,
+		bytePtrType,
+		&frameAddressValue
+		);
+
+	m_module->m_llvmIrBuilder.createLoad (stackLimitVariable, bytePtrType, &stackLimitValue);
+	m_module->m_llvmIrBuilder.createLt_u (frameAddressValue, stackLimitValue, &cmpValue);
+
+	BasicBlock* overflowBlock = m_module->m_controlFlowMgr.createBlock ("stack_overflow");
+	BasicBlock* followBlock = m_module->m_controlFlowMgr.createBlock ("stack_ok");
+	condJumpUnlikely (cmpValue, overflowBlock, followBlock, overflowBlock);
+
 	Function* function = m_module->m_functionMgr.getStdFunction (StdFunc_CheckStackOverflow);
 	m_module->m_llvmIrBuilder.createCall (function, function->getType (), NULL);
+	m_module->m_controlFlowMgr.follow (followBlock);
 }
 
 void
@@ -18,6 +18,100 @@ namespace ct {
 
 //..............................................................................
 
+// alloc sizes of these don't depend on the target data layout
+
+static
+bool
+getScalarLlvmTypeSize (
+	llvm::Type* llvmType,
+	size_t* size
+	)
+{
+	if (llvmType->isIntegerTy ())
+	{
+		size_t bitCount = llvmType->getIntegerBitWidth ();
+		if (bitCount < 8 || (bitCount & (bitCount - 1)))
+			return false;
+
+		*size = bitCount / 8;
+		return true;
+	}
+
+	if (llvmType->isFloatTy ())
+	{
+		*size = 4;
+		return true;
+	}
+
+	if (llvmType->isDoubleTy ())
+	{
+		*size = 8;
+		return true;
+	}
+
+	return false;
+}
+
+// walks casts and constant-index GEPs over scalars (or arrays of scalars)
+// from the pointer back to the base; succeeds if the base is reached
+
+static
+bool
+getConstPtrOffset (
+	llvm::Value* llvmPtr,
+	llvm::Value* llvmBase,
+	intptr_t* offset
+	)
+{
+	intptr_t result = 0;
+	llvmBase = llvmBase->stripPointerCasts ();
+
+	for (;;)
+	{
+		llvmPtr = llvmPtr->stripPointerCasts (); // also strips all-zero GEPs
+		if (llvmPtr == llvmBase)
+		{
+			*offset = result;
+			return true;
+		}
+
+		llvm::GEPOperator* llvmGep = llvm::dyn_cast <llvm::GEPOperator> (llvmPtr);
+		if (!llvmGep || !llvmGep->hasAllConstantIndices ())
+			return false;
+
+		llvm::Type* llvmElementType = llvmGep->getPointerOperandType ()->getPointerElementType ();
+		llvm::ConstantInt* llvmIdx;
+		size_t elementSize;
+
+		switch (llvmGep->getNumIndices ())
+		{
+		case 1: // p + i
+			llvmIdx = llvm::cast <llvm::ConstantInt> (llvmGep->getOperand (1));
+			break;
+
+		case 2: // &a [0] [i]
+			if (!llvm::cast <llvm::ConstantInt> (llvmGep->getOperand (1))->isZero () ||
+				!llvmElementType->isArrayTy ())
+				return false;
+
+			llvmElementType = llvmElementType->getArrayElementType ();
+			llvmIdx = llvm::cast <llvm::ConstantInt> (llvmGep->getOperand (2));
+			break;
+
+		default:
+			return false;
+		}
+
+		if (!getScalarLlvmTypeSize (llvmElementType, &elementSize))
+			return false;
+
+		result += (intptr_t) llvmIdx->getSExtValue () * elementSize;
+		llvmPtr = llvmGep->getPointerOperand ();
+	}
+}
+
+//..............................................................................
+
 void
 OperatorMgr::checkPtr (
 	StdFunc stdCheckFunction,
@@ -73,6 +167,8 @@ OperatorMgr::checkDataPtrRange (const Value& value)
 		ptrTypeKind == DataPtrTypeKind_Thin)
 		return true;
 
+	Type* bytePtrType = m_module->m_typeMgr.getStdType (StdType_BytePtr);
+	Type* sizeType = m_module->m_typeMgr.getPrimitiveType (TypeKind_SizeT);
 	size_t targetSize = type->getTargetType ()->getSize ();
 
 	Value ptrValue;
@@ -87,7 +183,7 @@ OperatorMgr::checkDataPtrRange (const Value& value)
 	{
 		ASSERT (ptrTypeKind == DataPtrTypeKind_Lean);
 
-		m_module->m_llvmIrBuilder.createBitCast (value, m_module->m_typeMgr.getStdType (StdType_BytePtr), &ptrValue);
+		m_module->m_llvmIrBuilder.createBitCast (value, bytePtrType, &ptrValue);
 
 		LeanDataPtrValidator* validator = value.getLeanDataPtrValidator ();
 		if (validator->isDynamicRange () || validator->hasValidatorValue ())
@@ -106,16 +202,39 @@ OperatorMgr::checkDataPtrRange (const Value& value)
 			rangeLength -= targetSize;
 
 			Value rangeBeginValue = validator->getRangeBeginValue ();
-			m_module->m_llvmIrBuilder.createBitCast (rangeBeginValue, m_module->m_typeMgr.getStdType (StdType_BytePtr), &rangeBeginValue);
+
+			// pointers at a constant offset from the range begin (locals and
+			// their elements addressed with constant indices) are demoted to
+			// raw pointers -- the range is proven at compile time
+
+			intptr_t offset;
+			if (getConstPtrOffset (value.getLlvmValue (), rangeBeginValue.getLlvmValue (), &offset) &&
+				offset >= 0 && (size_t) offset <= rangeLength)
+				return true;
+
+			m_module->m_llvmIrBuilder.createBitCast (rangeBeginValue, bytePtrType, &rangeBeginValue);
 
 			Value argValueArray [] =
 			{
 				ptrValue,
 				rangeBeginValue,
-				Value (rangeLength, m_module->m_typeMgr.getPrimitiveType (TypeKind_SizeT)),
+				Value (rangeLength, sizeType),
 			};
 
-			checkPtr (
+			// p < rangeBegin || p > rangeBegin + rangeLength
+
+			Value rangeEndValue;
+			Value cmpValue1;
+			Value cmpValue2;
+			Value failValue;
+
+			m_module->m_llvmIrBuilder.createGep (rangeBeginValue, argValueArray [2], bytePtrType, &rangeEndValue);
+			m_module->m_llvmIrBuilder.createLt_u (ptrValue, rangeBeginValue, &cmpValue1);
+			m_module->m_llvmIrBuilder.createGt_u (ptrValue, rangeEndValue, &cmpValue2);
+			m_module->m_llvmIrBuilder.createOr (cmpValue1, cmpValue2, cmpValue1.getType (), &failValue);
+
+			checkPtrInline (
+				failValue,
 				StdFunc_CheckDataPtrRangeDirect,
 				StdFunc_TryCheckDataPtrRangeDirect,
 				argValueArray,
@@ -128,20 +247,112 @@ OperatorMgr::checkDataPtrRange (const Value& value)
 	Value argValueArray [] =
 	{
 		ptrValue,
-		Value (targetSize, m_module->m_typeMgr.getPrimitiveType (TypeKind_SizeT)),
+		Value (targetSize, sizeType),
 		validatorValue,
 	};
 
-	checkPtr (
+	// !validator || p < validator->m_rangeBegin || p + size > validator->m_rangeEnd
+	// range fields are only loaded after the validator is known to be non-null
+
+	BasicBlock* failBlock = m_module->m_controlFlowMgr.createBlock ("range_fail");
+	BasicBlock* rangeBlock = m_module->m_controlFlowMgr.createBlock ("range_check");
+
+	Value nullValue = m_module->m_typeMgr.getStdType (StdType_DataPtrValidatorPtr)->getZeroValue ();
+	Value failValue;
+
+	m_module->m_llvmIrBuilder.createEq_i (validatorValue, nullValue, &failValue);
+	condJumpUnlikely (failValue, failBlock, rangeBlock);
+
+	Value rangeBeginValue;
+	Value rangeEndValue;
+	Value endValue;
+	Value cmpValue1;
+	Value cmpValue2;
+
+	m_module->m_llvmIrBuilder.createGep2 (validatorValue, 2, NULL, &rangeBeginValue); // DataPtrValidator.m_rangeBegin
+	m_module->m_llvmIrBuilder.createLoad (rangeBeginValue, bytePtrType, &rangeBeginValue);
+	m_module->m_llvmIrBuilder.createGep2 (validatorValue, 3, NULL, &rangeEndValue);   // DataPtrValidator.m_rangeEnd
+	m_module->m_llvmIrBuilder.createLoad (rangeEndValue, bytePtrType, &rangeEndValue);
+	m_module->m_llvmIrBuilder.createGep (ptrValue, argValueArray [1], bytePtrType, &endValue);
+	m_module->m_llvmIrBuilder.createLt_u (ptrValue, rangeBeginValue, &cmpValue1);
+	m_module->m_llvmIrBuilder.createGt_u (endValue, rangeEndValue, &cmpValue2);
+	m_module->m_llvmIrBuilder.createOr (cmpValue1, cmpValue2, cmpValue1.getType (), &failValue);
+
+	checkPtrInline (
+		failValue,
 		StdFunc_CheckDataPtrRangeIndirect,
 		StdFunc_TryCheckDataPtrRangeIndirect,
 		argValueArray,
-		countof (argValueArray)
+		countof (argValueArray),
+		failBlock
 		);
 
 	return true;
 }
 
+void
+OperatorMgr::checkPtrInline (
+	const Value& failValue,
+	StdFunc stdCheckFunction,
+	StdFunc stdTryCheckFunction,
+	const Value* argValueArray,
+	size_t argCount,
+	BasicBlock* failBlock
+	)
+{
+	if (!failBlock)
+		failBlock = m_module->m_controlFlowMgr.createBlock ("check_fail");
+
+	BasicBlock* followBlock = m_module->m_controlFlowMgr.createBlock ("check_follow");
+	condJumpUnlikely (failValue, failBlock, followBlock, failBlock);
+
+	// the out-of-line check function re-validates and produces the error
+
+	checkPtr (stdCheckFunction, stdTryCheckFunction, argValueArray, argCount);
+
+	Scope* scope = m_module->m_namespaceMgr.getCurrentScope ();
+	if (scope->canStaticThrow ())
+	{
+		m_module->m_controlFlowMgr.follow (followBlock);
+	}
+	else
+	{
+		// non-try check functions never return; this lets LLVM treat the
+		// check as a guard and hoist/merge what follows it
+
+		m_module->m_llvmIrBuilder.createUnreachable ();
+		m_module->m_controlFlowMgr.setCurrentBlock (followBlock);
+	}
+
+	m_module->m_functionMgr.getCurrentFunction ()->m_flags |= FunctionFlag_InlineRangeCheck;
+}
+
+void
+OperatorMgr::condJumpUnlikely (
+	const Value& value,
+	BasicBlock* thenBlock,
+	BasicBlock* elseBlock,
+	BasicBlock* followBlock
+	)
+{
+	BasicBlock* block = m_module->m_controlFlowMgr.getCurrentBlock ();
+
+	bool result = m_module->m_controlFlowMgr.conditionalJump (
+		value,
+		thenBlock,
+		elseBlock,
+		followBlock ? followBlock : elseBlock
+		);
+
+	ASSERT (result);
+
+	llvm::TerminatorInst* llvmBr = block->getLlvmBlock ()->getTerminator ();
+	ASSERT (llvm::isa <llvm::BranchInst> (llvmBr));
+
+	llvm::MDBuilder llvmMdBuilder (*m_module->getLlvmContext ());
+	llvmBr->setMetadata (llvm::LLVMContext::MD_prof, llvmMdBuilder.createBranchWeights (1, 2000));
+}
+
 void
 OperatorMgr::checkNullPtr (const Value& value)
 {
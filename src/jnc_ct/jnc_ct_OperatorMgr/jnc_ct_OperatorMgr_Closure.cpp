@@ -120,7 +120,153 @@ OperatorMgr::createClosureObject (
 			);
 	}
 
-	// create instance
+	// closures of a direct function with constant-only captures are immutable,
+	// so a single instance per site can be cached and reused
+
+	if (thunkType->getTypeKind () == TypeKind_Function && !isWeak && isConstClosure (opValue))
+		return getCachedClosureObject (opValue, closureType, resultValue);
+
+	return initClosureObject (opValue, closureType, resultValue);
+}
+
+bool
+OperatorMgr::isConstClosure (const Value& opValue)
+{
+	if (opValue.getValueKind () != ValueKind_Function)
+		return false;
+
+	Closure* closure = opValue.getClosure ();
+	if (!closure)
+		return true;
+
+	sl::BoxIterator <Value> closureArgValue = closure->getArgValueList ()->getHead ();
+	for (; closureArgValue; closureArgValue++)
+	{
+		ValueKind valueKind = closureArgValue->getValueKind ();
+		if (valueKind != ValueKind_Void &&
+			valueKind != ValueKind_Null &&
+			valueKind != ValueKind_Const)
+			return false;
+	}
+
+	return true;
+}
+
+bool
+OperatorMgr::getCachedClosureObject (
+	const Value& opValue,
+	ClosureClassType* closureType,
+	Value* resultValue
+	)
+{
+	bool result;
+
+	ClassPtrType* closurePtrType = closureType->getClassPtrType ();
+
+	Variable* cacheVariable = m_module->m_variableMgr.createVariable (
+		StorageKind_Static,
+		"closureCache",
+		"jnc.closureCache",
+		closurePtrType
+		);
+
+	m_closureCacheVariableArray.append (cacheVariable);
+
+	BasicBlock* createBlock = m_module->m_controlFlowMgr.createBlock ("create_closure");
+	BasicBlock* followBlock = m_module->m_controlFlowMgr.createBlock ("create_closure_follow");
+
+	Value cachedValue;
+	Value cmpValue;
+	m_module->m_llvmIrBuilder.createLoad (cacheVariable, closurePtrType, &cachedValue);
+	m_module->m_llvmIrBuilder.createEq_i (cachedValue, closurePtrType->getZeroValue (), &cmpValue);
+
+	BasicBlock* cachedBlock = m_module->m_controlFlowMgr.getCurrentBlock ();
+	m_module->m_controlFlowMgr.conditionalJump (cmpValue, createBlock, followBlock, createBlock);
+
+	// a race between threads may create an extra instance -- harmless,
+	// as any of them is a valid closure for this site (the loser is collected)
+
+	Value closureValue;
+	result = initClosureObject (opValue, closureType, &closureValue);
+	if (!result)
+		return false;
+
+	// publish with release semantics so that other threads never observe
+	// the cached pointer before the fields of the closure are stored
+
+	Type* intPtrType = m_module->m_typeMgr.getPrimitiveType (TypeKind_IntPtr);
+
+	Value cachePtrValue;
+	Value intValue;
+	Value tmpValue;
+	m_module->m_llvmIrBuilder.createBitCast (cacheVariable, intPtrType->getDataPtrType_c (), &cachePtrValue);
+	m_module->m_llvmIrBuilder.createPtrToInt (closureValue, intPtrType, &intValue);
+	m_module->m_llvmIrBuilder.createCmpXchg (
+		cachePtrValue,
+		intPtrType->getZeroValue (),
+		intValue,
+#if (LLVM_VERSION < 0x0305)
+		llvm::AcquireRelease,
+#elif (LLVM_VERSION < 0x0309)
+		llvm::AcquireRelease,
+		llvm::Acquire,
+#else
+		llvm::AtomicOrdering::AcquireRelease,
+		llvm::AtomicOrdering::Acquire,
+#endif
+		llvm::DefaultSynchronizationScope_vn,
+		&tmpValue
+		);
+
+	BasicBlock* createdBlock = m_module->m_controlFlowMgr.getCurrentBlock ();
+	m_module->m_controlFlowMgr.follow (followBlock);
+
+	m_module->m_llvmIrBuilder.createPhi (
+		cachedValue,
+		cachedBlock,
+		closureValue,
+		createdBlock,
+		resultValue
+		);
+
+	return true;
+}
+
+void
+OperatorMgr::injectClosureCacheReset ()
+{
+	// cached closures are freed when the runtime shuts down, so the module
+	// constructor must clear the slots -- otherwise the next startup picks
+	// up dangling pointers
+
+	size_t count = m_closureCacheVariableArray.getCount ();
+	if (!count)
+		return;
+
+	Function* constructor = m_module->getConstructor ();
+	ASSERT (constructor);
+
+	BasicBlock* block = constructor->getPrologueBlock ();
+	ASSERT (block);
+
+	m_module->m_controlFlowMgr.setCurrentBlock (block);
+	m_module->m_llvmIrBuilder.setInsertPoint (&*block->getLlvmBlock ()->begin ());
+
+	for (size_t i = 0; i < count; i++)
+	{
+		Variable* variable = m_closureCacheVariableArray [i];
+		m_module->m_llvmIrBuilder.createStore (variable->getType ()->getZeroValue (), variable);
+	}
+}
+
+bool
+OperatorMgr::initClosureObject (
+	const Value& opValue,
+	ClosureClassType* closureType,
+	Value* resultValue
+	)
+{
+	bool result;
 
 	Value closureValue;
 	result = m_module->m_operatorMgr.newOperator (closureType, NULL, &closureValue);
@@ -147,6 +293,7 @@ OperatorMgr::createClosureObject (
 
 	// save closure arguments (if any)
 
+	Closure* closure = opValue.getClosure ();
 	if (closure)
 	{
 		sl::BoxIterator <Value> closureArgValue = closure->getArgValueList ()->getHead ();
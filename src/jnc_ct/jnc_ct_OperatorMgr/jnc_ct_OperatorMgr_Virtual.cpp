@@ -39,6 +39,61 @@ OperatorMgr::getClassVTable (
 	return true;
 }
 
+Function*
+OperatorMgr::findDevirtualizedMethod (
+	ClassType* classType,
+	size_t vtableIndex
+	)
+{
+	ASSERT (m_module->getCompileState () >= ModuleCompileState_LayoutCalculated);
+
+	if (classType->getFlags () & ClassTypeFlag_Opaque)
+		return NULL;
+
+	sl::Array <Function*> vtable = classType->getVTable ();
+	if (vtableIndex >= vtable.getCount ())
+		return NULL;
+
+	Function* function = vtable [vtableIndex];
+	return
+		function->getStorageKind () != StorageKind_Abstract &&
+		!(function->getFlags () & FunctionFlag_Overridden) ? function : NULL;
+}
+
+void
+OperatorMgr::devirtualizeCalls ()
+{
+	// function-local classes and lazily parsed library types only get their
+	// layouts calculated while bodies are being compiled, so the class
+	// hierarchy is closed only after the whole compile array is processed
+
+	size_t count = m_virtualCallSiteArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+	{
+		VirtualCallSite* callSite = &m_virtualCallSiteArray [i];
+		Function* function = findDevirtualizedMethod (callSite->m_classType, callSite->m_vtableIndex);
+		if (!function)
+			continue;
+
+		llvm::LoadInst* llvmMethodLoad = callSite->m_llvmMethodLoad;
+		llvm::Value* llvmFunction = llvm::ConstantExpr::getBitCast (
+			function->getLlvmFunction (),
+			llvmMethodLoad->getType ()
+			);
+
+		llvmMethodLoad->replaceAllUsesWith (llvmFunction);
+		llvmMethodLoad->eraseFromParent ();
+
+		// unless null checks are explicit, the vtable load is what faults on
+		// a null receiver -- it must survive dead code elimination
+
+		if (!(m_module->getCompileFlags () & ModuleCompileFlag_SimpleCheckNullPtr))
+			callSite->m_llvmVTableLoad->setVolatile (true);
+	}
+
+	m_virtualCallSiteArray.clear ();
+}
+
 bool
 OperatorMgr::getVirtualMethod (
 	Function* function,
@@ -68,6 +123,8 @@ OperatorMgr::getVirtualMethod (
 	Value ptrValue;
 	getClassVTable (value, classType, &ptrValue);
 
+	llvm::LoadInst* llvmVTableLoad = llvm::cast <llvm::LoadInst> (ptrValue.getLlvmValue ()->stripPointerCasts ());
+
 	// p*
 
 	m_module->m_llvmIrBuilder.createGep2 (
@@ -79,12 +136,21 @@ OperatorMgr::getVirtualMethod (
 
 	// p
 
-	m_module->m_llvmIrBuilder.createLoad (
+	llvm::LoadInst* llvmMethodLoad = m_module->m_llvmIrBuilder.createLoad (
 		ptrValue,
 		NULL,
 		&ptrValue
 		);
 
+	// candidate for devirtualization once the class hierarchy is closed
+
+	VirtualCallSite callSite;
+	callSite.m_classType = classType;
+	callSite.m_vtableIndex = VTableIndex;
+	callSite.m_llvmVTableLoad = llvmVTableLoad;
+	callSite.m_llvmMethodLoad = llvmMethodLoad;
+	m_virtualCallSiteArray.append (callSite);
+
 	resultValue->setLlvmValue (
 		ptrValue.getLlvmValue (),
 		function->getType ()->getFunctionPtrType (FunctionPtrTypeKind_Thin)
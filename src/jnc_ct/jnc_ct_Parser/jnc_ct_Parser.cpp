@@ -2705,6 +2705,17 @@ Parser::finalizeLiteral (
 
 	Value fmtLiteralValue = fmtLiteral;
 
+	// remember where to put the buffer reservation once the size estimate is known
+
+	LlvmIrInsertPoint reserveInsertPoint;
+	m_module->m_llvmIrBuilder.saveInsertPoint (&reserveInsertPoint);
+
+	// constant text (including constant site values) is accumulated and then
+	// appended with a single call right before the next run-time site
+
+	sl::String constText;
+	size_t appendCount = 0;
+	size_t sizeEstimate = 0;
 	size_t offset = 0;
 
 	sl::BitMap argUsageMap;
@@ -2736,12 +2747,7 @@ Parser::finalizeLiteral (
 		if (site->m_offset > offset)
 		{
 			size_t length = site->m_offset - offset;
-			appendFmtLiteralRawData (
-				fmtLiteralValue,
-				literal->m_binData + offset,
-				length
-				);
-
+			constText.append (literal->m_binData + offset, length);
 			offset += length;
 		}
 
@@ -2751,9 +2757,23 @@ Parser::finalizeLiteral (
 			return false;
 		}
 
-		result = appendFmtLiteralValue (fmtLiteralValue, *value, site->m_fmtSpecifierString);
+		result = appendFmtLiteralConstValue (&constText, *value, site->m_fmtSpecifierString);
+		if (result)
+			continue;
+
+		if (!constText.isEmpty ())
+		{
+			appendFmtLiteralRawData (fmtLiteralValue, constText.sz (), constText.getLength ());
+			sizeEstimate += constText.getLength ();
+			appendCount++;
+			constText.clear ();
+		}
+
+		result = appendFmtLiteralValue (fmtLiteralValue, *value, site->m_fmtSpecifierString, &sizeEstimate);
 		if (!result)
 			return false;
+
+		appendCount++;
 	}
 
 	size_t unusedArgIdx = argUsageMap.findBit (0, false);
@@ -2765,13 +2785,39 @@ Parser::finalizeLiteral (
 
 	size_t endOffset = literal->m_binData.getCount ();
 	if (endOffset > offset)
+		constText.append (literal->m_binData + offset, endOffset - offset);
+
+	if (!constText.isEmpty ())
+	{
+		appendFmtLiteralRawData (fmtLiteralValue, constText.sz (), constText.getLength ());
+		sizeEstimate += constText.getLength ();
+		appendCount++;
+	}
+
+	// with more than one append, reserve the buffer upfront so that it doesn't
+	// get re-allocated as the literal grows (a single append allocates exactly)
+
+	if (appendCount > 1)
 	{
-		size_t length = endOffset - offset;
-		appendFmtLiteralRawData (
+		Function* reserve = m_module->m_functionMgr.getStdFunction (StdFunc_ReserveFmtLiteral);
+
+		Value sizeValue;
+		sizeValue.setConstSizeT (sizeEstimate, m_module);
+
+		LlvmIrInsertPoint prevInsertPoint;
+		bool isInsertPointChanged = m_module->m_llvmIrBuilder.restoreInsertPoint (reserveInsertPoint, &prevInsertPoint);
+
+		Value resultValue;
+		m_module->m_llvmIrBuilder.createCall2 (
+			reserve,
+			reserve->getType (),
 			fmtLiteralValue,
-			literal->m_binData + offset,
-			length
+			sizeValue,
+			&resultValue
 			);
+
+		if (isInsertPointChanged)
+			m_module->m_llvmIrBuilder.restoreInsertPoint (prevInsertPoint);
 	}
 
 	Type* validatorType = m_module->m_typeMgr.getStdType (StdType_DataPtrValidatorPtr);
@@ -2821,15 +2867,89 @@ Parser::appendFmtLiteralRawData (
 		);
 }
 
+bool
+Parser::appendFmtLiteralConstValue (
+	sl::String* constText,
+	const Value& value,
+	const sl::StringRef& fmtSpecifierString
+	)
+{
+	// only default-formatted constants are folded -- this way, the output is
+	// guaranteed to match what appendFmtLiteral_* would produce at run time
+
+	if (value.getValueKind () != ValueKind_Const || !fmtSpecifierString.isEmpty ())
+		return false;
+
+	Type* type = value.getType ();
+	uint_t typeKindFlags = type->getTypeKindFlags ();
+	const void* p = value.getConstData ();
+
+	if (isCharArrayType (type))
+	{
+		const char* c = (const char*) p;
+		size_t size = type->getSize ();
+		size_t length = 0;
+
+		while (length < size && c [length])
+			length++;
+
+		constText->append (c, length);
+		return true;
+	}
+
+	if (!(typeKindFlags & TypeKindFlag_Integer) || (typeKindFlags & TypeKindFlag_BigEndian))
+		return false;
+
+	bool isUnsigned = (typeKindFlags & TypeKindFlag_Unsigned) != 0;
+	uint64_t x;
+
+	switch (type->getSize ())
+	{
+	case 1:
+		x = isUnsigned ? (uint64_t) *(const uint8_t*) p : (uint64_t) (int64_t) *(const int8_t*) p;
+		break;
+
+	case 2:
+		x = isUnsigned ? (uint64_t) *(const uint16_t*) p : (uint64_t) (int64_t) *(const int16_t*) p;
+		break;
+
+	case 4:
+		x = isUnsigned ? (uint64_t) *(const uint32_t*) p : (uint64_t) (int64_t) *(const int32_t*) p;
+		break;
+
+	case 8:
+		x = *(const uint64_t*) p;
+		break;
+
+	default:
+		return false;
+	}
+
+	if (isUnsigned)
+		constText->appendFormat ("%llu", x);
+	else
+		constText->appendFormat ("%lld", (int64_t) x);
+
+	return true;
+}
+
 bool
 Parser::appendFmtLiteralValue (
 	const Value& fmtLiteralValue,
 	const Value& rawSrcValue,
-	const sl::StringRef& fmtSpecifierString
+	const sl::StringRef& fmtSpecifierString,
+	size_t* sizeEstimate
 	)
 {
 	if (fmtSpecifierString == "B") // binary format
+	{
+		Type* type = rawSrcValue.getType ();
+		if (type->getTypeKind () == TypeKind_DataRef)
+			type = ((DataPtrType*) type)->getTargetType ();
+
+		*sizeEstimate += type->getSize ();
 		return appendFmtLiteralBinValue (fmtLiteralValue, rawSrcValue);
+	}
 
 	Value srcValue;
 	bool result = m_module->m_operatorMgr.prepareOperand (rawSrcValue, &srcValue);
@@ -2854,10 +2974,12 @@ Parser::appendFmtLiteralValue (
 		size_t i2 = (typeKindFlags & TypeKindFlag_Unsigned) != 0;
 
 		appendFunc = funcTable [i1] [i2];
+		*sizeEstimate += i1 ? 20 : 11; // max decimal length incl. sign
 	}
 	else if (typeKindFlags & TypeKindFlag_Fp)
 	{
 		appendFunc = StdFunc_AppendFmtLiteral_f;
+		*sizeEstimate += 16; // typical, not max
 	}
 	else if (typeKind == TypeKind_Variant)
 	{
@@ -0,0 +1,63 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#include "pch.h"
+#include "jnc_ct_TokenCache.h"
+
+namespace jnc {
+namespace ct {
+
+//..............................................................................
+
+const sl::BoxList <Token>*
+TokenCache::getTokenList (
+	const sl::StringRef& fileName,
+	const sl::StringRef& source
+	)
+{
+	m_lock.lock ();
+
+	sl::HashTableIterator <const char*, Entry*> it = m_entryMap.visit (source.cp ());
+	if (it->m_value && it->m_value->m_length == source.getLength ())
+	{
+		const sl::BoxList <Token>* tokenList = &it->m_value->m_tokenList;
+		m_lock.unlock ();
+		return tokenList;
+	}
+
+	Entry* entry = AXL_MEM_NEW (Entry);
+	entry->m_length = source.getLength ();
+
+	Lexer lexer;
+	lexer.create (fileName, source);
+
+	for (;;)
+	{
+		const Token* token = lexer.getToken ();
+		entry->m_tokenList.insertTail (*token);
+
+		if (token->m_token == TokenKind_Eof || token->m_token == TokenKind_Error)
+			break;
+
+		lexer.nextToken ();
+	}
+
+	m_entryList.insertTail (entry);
+	it->m_value = entry; // the previous entry (if any) stays in the list
+	m_lock.unlock ();
+
+	return &entry->m_tokenList;
+}
+
+//..............................................................................
+
+} // namespace ct
+} // namespace jnc
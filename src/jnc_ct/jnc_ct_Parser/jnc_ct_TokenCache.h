@@ -0,0 +1,62 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#pragma once
+
+#include "jnc_ct_Lexer.h"
+
+namespace jnc {
+namespace ct {
+
+//..............................................................................
+
+// process-wide cache of pre-lexed token lists for sources of static extension
+// libs; such sources are lexed once per process rather than once per module
+
+class TokenCache
+{
+protected:
+	struct Entry: sl::ListLink
+	{
+		size_t m_length;
+		sl::BoxList <Token> m_tokenList;
+	};
+
+	typedef sl::HashTable <const char*, Entry*, sl::HashId <const char*> > EntryMap;
+
+protected:
+	sys::Lock m_lock;
+	sl::List <Entry> m_entryList;
+	EntryMap m_entryMap;
+
+public:
+	// source must outlive the cache (i.e. be static)
+
+	const sl::BoxList <Token>*
+	getTokenList (
+		const sl::StringRef& fileName,
+		const sl::StringRef& source
+		);
+};
+
+// . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
+
+inline
+TokenCache*
+getTokenCache ()
+{
+	return sl::getSimpleSingleton <TokenCache> ();
+}
+
+//..............................................................................
+
+} // namespace ct
+} // namespace jnc
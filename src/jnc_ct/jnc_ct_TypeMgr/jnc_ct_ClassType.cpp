@@ -682,6 +682,7 @@ ClassType::overrideVirtualFunction (Function* function)
 	size_t VTableIndex = coord.m_vtableIndex + overridenFunction->m_classVTableIndex;
 	ASSERT (VTableIndex < m_vtable.getCount ());
 	m_vtable [VTableIndex] = function;
+	overridenFunction->m_flags |= FunctionFlag_Overridden;
 	return true;
 }
 
@@ -134,6 +134,12 @@ public:
 		return m_classMemberFieldArray;
 	}
 
+	sl::Array <Function*>
+	getVTable ()
+	{
+		return m_vtable;
+	}
+
 	sl::Array <Function*>
 	getVirtualMethodArray ()
 	{
@@ -105,6 +105,30 @@ TypeMgr::clear ()
 	m_parseStdTypeLevel = 0;
 }
 
+size_t
+TypeMgr::getTypeCount ()
+{
+	return
+		m_arrayTypeList.getCount () +
+		m_bitFieldTypeList.getCount () +
+		m_enumTypeList.getCount () +
+		m_structTypeList.getCount () +
+		m_unionTypeList.getCount () +
+		m_classTypeList.getCount () +
+		m_functionTypeList.getCount () +
+		m_propertyTypeList.getCount () +
+		m_dataPtrTypeList.getCount () +
+		m_classPtrTypeList.getCount () +
+		m_functionPtrTypeList.getCount () +
+		m_propertyPtrTypeList.getCount () +
+		m_reactorClassTypeList.getCount () +
+		m_functionClosureClassTypeList.getCount () +
+		m_propertyClosureClassTypeList.getCount () +
+		m_dataClosureClassTypeList.getCount () +
+		m_multicastClassTypeList.getCount () +
+		m_mcSnapshotClassTypeList.getCount ();
+}
+
 Type*
 TypeMgr::getStdType (StdType stdType)
 {
@@ -146,6 +146,9 @@ public:
 	void
 	clear ();
 
+	size_t
+	getTypeCount ();
+
 	bool
 	resolveImportTypes ();
 
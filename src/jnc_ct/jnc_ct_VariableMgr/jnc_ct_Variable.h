@@ -28,6 +28,7 @@ enum StdVariable
 {
 	StdVariable_SjljFrame,
 	StdVariable_GcShadowStackTop,
+	StdVariable_StackLimit,
 	StdVariable_GcSafePointTrigger,
 	StdVariable_NullPtrCheckSink,
 	StdVariable__Count,
@@ -52,6 +52,7 @@ VariableMgr::createStdVariables ()
 
 	getStdVariable (StdVariable_SjljFrame);
 	getStdVariable (StdVariable_GcShadowStackTop);
+	getStdVariable (StdVariable_StackLimit);
 }
 
 Variable*
@@ -84,6 +85,15 @@ VariableMgr::getStdVariable (StdVariable stdVariable)
 			);
 		break;
 
+	case StdVariable_StackLimit:
+		variable = createVariable (
+			StorageKind_Tls,
+			"g_stackLimit",
+			"jnc.g_stackLimit",
+			m_module->m_typeMgr.getStdType (StdType_BytePtr)
+			);
+		break;
+
 	case StdVariable_GcSafePointTrigger:
 		variable = createVariable (
 			StorageKind_Static,
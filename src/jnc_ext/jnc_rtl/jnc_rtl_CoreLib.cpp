@@ -300,6 +300,240 @@ variantUnaryOperator (
 	return result;
 }
 
+// fast paths for the most common variant operands -- int/int, double/double,
+// int/double and same-type pointers; everything else (as well as the operators
+// with error conditions, e.g. division of integers) goes through the compiler's
+// operator machinery
+
+static
+bool
+getVariantFastOperand (
+	const jnc_Variant& variant,
+	int64_t* intValue,
+	double* fpValue,
+	bool* isFp
+	)
+{
+	if (!variant.m_type)
+		return false;
+
+	switch (variant.m_type->getTypeKind ())
+	{
+	case TypeKind_Int32:
+		*intValue = variant.m_int32;
+		*isFp = false;
+		return true;
+
+	case TypeKind_Int64:
+		*intValue = variant.m_int64;
+		*isFp = false;
+		return true;
+
+	case TypeKind_Double:
+		*fpValue = variant.m_double;
+		*isFp = true;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+template <typename T>
+static
+bool
+relationalOperatorFast (
+	int opKind,
+	T value1,
+	T value2
+	)
+{
+	switch (opKind)
+	{
+	case BinOpKind_Eq:
+		return value1 == value2;
+
+	case BinOpKind_Ne:
+		return value1 != value2;
+
+	case BinOpKind_Lt:
+		return value1 < value2;
+
+	case BinOpKind_Le:
+		return value1 <= value2;
+
+	case BinOpKind_Gt:
+		return value1 > value2;
+
+	case BinOpKind_Ge:
+		return value1 >= value2;
+
+	default:
+		ASSERT (false);
+		return false;
+	}
+}
+
+static
+bool
+variantBinaryOperatorFast (
+	int opKind,
+	const jnc_Variant& variant1,
+	const jnc_Variant& variant2,
+	jnc_Variant* result
+	)
+{
+	int64_t intValue1;
+	int64_t intValue2;
+	double fpValue1;
+	double fpValue2;
+	bool isFp1;
+	bool isFp2;
+
+	if (!getVariantFastOperand (variant1, &intValue1, &fpValue1, &isFp1) ||
+		!getVariantFastOperand (variant2, &intValue2, &fpValue2, &isFp2))
+		return false;
+
+	if (isFp1 || isFp2)
+	{
+		if (!isFp1)
+			fpValue1 = (double) intValue1;
+
+		if (!isFp2)
+			fpValue2 = (double) intValue2;
+
+		switch (opKind)
+		{
+		case BinOpKind_Add:
+			result->m_double = fpValue1 + fpValue2;
+			break;
+
+		case BinOpKind_Sub:
+			result->m_double = fpValue1 - fpValue2;
+			break;
+
+		case BinOpKind_Mul:
+			result->m_double = fpValue1 * fpValue2;
+			break;
+
+		case BinOpKind_Div:
+			result->m_double = fpValue1 / fpValue2;
+			break;
+
+		default:
+			return false;
+		}
+
+		result->m_type = isFp1 ? variant1.m_type : variant2.m_type;
+		return true;
+	}
+
+	if (variant1.m_type != variant2.m_type) // int32 vs int64
+		return false;
+
+	// operate on unsigned to get the wrap-around of the narrow type
+
+	uint64_t value;
+
+	switch (opKind)
+	{
+	case BinOpKind_Add:
+		value = (uint64_t) intValue1 + (uint64_t) intValue2;
+		break;
+
+	case BinOpKind_Sub:
+		value = (uint64_t) intValue1 - (uint64_t) intValue2;
+		break;
+
+	case BinOpKind_Mul:
+		value = (uint64_t) intValue1 * (uint64_t) intValue2;
+		break;
+
+	case BinOpKind_BwAnd:
+		value = intValue1 & intValue2;
+		break;
+
+	case BinOpKind_BwXor:
+		value = intValue1 ^ intValue2;
+		break;
+
+	case BinOpKind_BwOr:
+		value = intValue1 | intValue2;
+		break;
+
+	default:
+		return false;
+	}
+
+	if (variant1.m_type->getTypeKind () == TypeKind_Int32)
+		result->m_int32 = (int32_t) value;
+	else
+		result->m_int64 = (int64_t) value;
+
+	result->m_type = variant1.m_type;
+	return true;
+}
+
+static
+bool
+variantRelationalOperatorFast (
+	int opKind,
+	const jnc_Variant& variant1,
+	const jnc_Variant& variant2,
+	bool* result
+	)
+{
+	int64_t intValue1;
+	int64_t intValue2;
+	double fpValue1;
+	double fpValue2;
+	bool isFp1;
+	bool isFp2;
+
+	if (getVariantFastOperand (variant1, &intValue1, &fpValue1, &isFp1) &&
+		getVariantFastOperand (variant2, &intValue2, &fpValue2, &isFp2))
+	{
+		if (!isFp1 && !isFp2)
+		{
+			*result = relationalOperatorFast (opKind, intValue1, intValue2);
+			return true;
+		}
+
+		if (!isFp1)
+			fpValue1 = (double) intValue1;
+
+		if (!isFp2)
+			fpValue2 = (double) intValue2;
+
+		*result = relationalOperatorFast (opKind, fpValue1, fpValue2);
+		return true;
+	}
+
+	// pointers of the very same type compare directly
+
+	Type* type = variant1.m_type;
+	if (!type || type != variant2.m_type)
+		return false;
+
+	uint_t typeKindFlags = type->getTypeKindFlags ();
+
+	if ((typeKindFlags & TypeKindFlag_DataPtr) &&
+		((DataPtrType*) type)->getPtrTypeKind () == DataPtrTypeKind_Normal)
+	{
+		*result = relationalOperatorFast (opKind, (uintptr_t) variant1.m_dataPtr.m_p, (uintptr_t) variant2.m_dataPtr.m_p);
+		return true;
+	}
+
+	if ((typeKindFlags & TypeKindFlag_ClassPtr) &&
+		(opKind == BinOpKind_Eq || opKind == BinOpKind_Ne))
+	{
+		*result = relationalOperatorFast (opKind, variant1.m_classPtr, variant2.m_classPtr);
+		return true;
+	}
+
+	return false;
+}
+
 jnc_Variant
 variantBinaryOperator (
 	int opKind,
@@ -308,7 +542,10 @@ variantBinaryOperator (
 	)
 {
 	jnc_Variant result = jnc::g_nullVariant;
-	variant1.binaryOperator (&variant2, (jnc_BinOpKind) opKind, &result);
+
+	if (!variantBinaryOperatorFast (opKind, variant1, variant2, &result))
+		variant1.binaryOperator (&variant2, (jnc_BinOpKind) opKind, &result);
+
 	return result;
 }
 
@@ -320,10 +557,89 @@ variantRelationalOperator (
 	)
 {
 	bool result = false;
-	variant1.relationalOperator (&variant2, (jnc_BinOpKind) opKind, &result);
+
+	if (!variantRelationalOperatorFast (opKind, variant1, variant2, &result))
+		variant1.relationalOperator (&variant2, (jnc_BinOpKind) opKind, &result);
+
 	return result;
 }
 
+// member access on class variants is cached per (dynamic type, name): a hit
+// is a type compare plus a direct load/store of the field; the cache is only
+// filled after the generic path succeeded, so access checks are preserved
+
+static
+bool
+getVariantMemberCached (
+	const Variant& variant,
+	const char* name,
+	jnc_Variant* result
+	)
+{
+	if (!variant.m_type || !variant.m_classPtr)
+		return false;
+
+	ct::StructField* field = variant.m_type->getModule ()->m_variantMemberCache.find (variant.m_type, name, false);
+	if (!field)
+		return false;
+
+	Type* fieldType = field->getType ();
+	memcpy (result, (char*) variant.m_classPtr + field->getOffset (), fieldType->getSize ());
+	result->m_type = fieldType;
+	return true;
+}
+
+static
+void
+getVariantMember (
+	const Variant& variant,
+	const char* name,
+	jnc_Variant* result
+	)
+{
+	if (getVariantMemberCached (variant, name, result))
+		return;
+
+	bool isOk = variant.getMember (name, result);
+	if (!isOk || !variant.m_type)
+		return;
+
+	ct::StructField* field = ct::VariantMemberCache::findCacheableField (variant.m_type, name);
+	if (field && result->m_type == field->getType ())
+		variant.m_type->getModule ()->m_variantMemberCache.add (variant.m_type, name, field, false);
+}
+
+static
+void
+setVariantMember (
+	Variant* variant,
+	const char* name,
+	const Variant& value
+	)
+{
+	ct::Module* module = variant->m_type ? variant->m_type->getModule () : NULL;
+
+	if (module && variant->m_classPtr && value.m_type)
+	{
+		ct::StructField* field = module->m_variantMemberCache.find (variant->m_type, name, true);
+		if (field && value.m_type == field->getType ())
+		{
+			memcpy ((char*) variant->m_classPtr + field->getOffset (), &value, value.m_type->getSize ());
+			return;
+		}
+	}
+
+	bool isOk = variant->setMember (name, value);
+	if (!isOk || !module)
+		return;
+
+	// only cache assignments of the very same type (no conversion needed)
+
+	ct::StructField* field = ct::VariantMemberCache::findCacheableField (variant->m_type, name);
+	if (field && value.m_type == field->getType ())
+		module->m_variantMemberCache.add (variant->m_type, name, field, true);
+}
+
 Variant
 variantMemberOperator (
 	jnc_Variant variant,
@@ -331,7 +647,7 @@ variantMemberOperator (
 	)
 {
 	jnc_Variant result = jnc::g_nullVariant;
-	variant.getMember (name, &result);
+	getVariantMember (variant, name, &result);
 	return result;
 }
 
@@ -354,7 +670,7 @@ variantMemberProperty_get (
 {
 	jnc_Variant result = jnc::g_nullVariant;
 	Variant* variant = (Variant*) variantPtr.m_p;
-	variant->getMember (name, &result);
+	getVariantMember (*variant, name, &result);
 	return result;
 }
 
@@ -366,7 +682,7 @@ variantMemberProperty_set (
 	)
 {
 	Variant* variant = (Variant*) variantPtr.m_p;
-	variant->setMember (name, value);
+	setVariantMember (variant, name, value);
 }
 
 Variant
@@ -749,34 +1065,60 @@ dynamicFieldCountOf (
 
 // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
 
-size_t
-appendFmtLiteral_a (
+static
+bool
+ensureFmtLiteralMaxLength (
 	FmtLiteral* fmtLiteral,
-	const char* p,
-	size_t length
+	size_t newLength
 	)
 {
+	if (newLength < 64)
+		newLength = 64;
+
+	if (fmtLiteral->m_maxLength >= newLength)
+		return true;
+
 	GcHeap* gcHeap = getCurrentThreadGcHeap ();
 	ASSERT (gcHeap);
 
-	size_t newLength = fmtLiteral->m_length + length;
-	if (newLength < 64)
-		newLength = 64;
+	size_t newMaxLength = sl::getAllocSize (newLength);
 
-	if (fmtLiteral->m_maxLength < newLength)
-	{
-		size_t newMaxLength = sl::getAllocSize (newLength);
+	DataPtr ptr = gcHeap->tryAllocateBuffer (newMaxLength + 1);
+	if (!ptr.m_p)
+		return false;
 
-		DataPtr ptr = gcHeap->tryAllocateBuffer (newMaxLength + 1);
-		if (!ptr.m_p)
-			return fmtLiteral->m_length;
+	if (fmtLiteral->m_length)
+		memcpy (ptr.m_p, fmtLiteral->m_ptr.m_p, fmtLiteral->m_length);
 
-		if (fmtLiteral->m_length)
-			memcpy (ptr.m_p, fmtLiteral->m_ptr.m_p, fmtLiteral->m_length);
+	fmtLiteral->m_ptr = ptr;
+	fmtLiteral->m_maxLength = newMaxLength;
 
-		fmtLiteral->m_ptr = ptr;
-		fmtLiteral->m_maxLength = newMaxLength;
-	}
+	// adjust validator
+
+	DataPtrValidator* validator = ptr.m_validator;
+	validator->m_rangeEnd = (char*) validator->m_rangeBegin + fmtLiteral->m_length;
+	return true;
+}
+
+void
+reserveFmtLiteral (
+	FmtLiteral* fmtLiteral,
+	size_t length
+	)
+{
+	ensureFmtLiteralMaxLength (fmtLiteral, fmtLiteral->m_length + length);
+}
+
+size_t
+appendFmtLiteral_a (
+	FmtLiteral* fmtLiteral,
+	const char* p,
+	size_t length
+	)
+{
+	bool result = ensureFmtLiteralMaxLength (fmtLiteral, fmtLiteral->m_length + length);
+	if (!result)
+		return fmtLiteral->m_length;
 
 	char* dst = (char*) fmtLiteral->m_ptr.m_p;
 	memcpy (dst + fmtLiteral->m_length, p, length);
@@ -790,6 +1132,65 @@ appendFmtLiteral_a (
 	return fmtLiteral->m_length;
 }
 
+// default-formatted integers (the most common case by far) bypass printf
+
+static
+size_t
+appendFmtLiteralDec (
+	FmtLiteral* fmtLiteral,
+	uint64_t x,
+	bool isNegative
+	)
+{
+	char buffer [32];
+	char* end = buffer + sizeof (buffer);
+	char* p = end;
+
+	do
+	{
+		*--p = '0' + (char) (x % 10);
+		x /= 10;
+	} while (x);
+
+	if (isNegative)
+		*--p = '-';
+
+	return appendFmtLiteral_a (fmtLiteral, p, end - p);
+}
+
+static
+size_t
+appendFmtLiteralHex (
+	FmtLiteral* fmtLiteral,
+	uint64_t x,
+	bool isUpperCase
+	)
+{
+	static const char lowerDigits [] = "0123456789abcdef";
+	static const char upperDigits [] = "0123456789ABCDEF";
+
+	const char* digits = isUpperCase ? upperDigits : lowerDigits;
+
+	char buffer [32];
+	char* end = buffer + sizeof (buffer);
+	char* p = end;
+
+	do
+	{
+		*--p = digits [x & 0xf];
+		x >>= 4;
+	} while (x);
+
+	return appendFmtLiteral_a (fmtLiteral, p, end - p);
+}
+
+inline
+bool
+isHexFmtSpecifier (const char* fmtSpecifier)
+{
+	return (fmtSpecifier [0] == 'x' || fmtSpecifier [0] == 'X') && !fmtSpecifier [1];
+}
+
 static
 void
 prepareFormatString (
@@ -905,6 +1306,12 @@ appendFmtLiteral_i32 (
 	int32_t x
 	)
 {
+	if (!fmtSpecifier)
+		return appendFmtLiteralDec (fmtLiteral, x < 0 ? 0 - (uint64_t) x : x, x < 0);
+
+	if (isHexFmtSpecifier (fmtSpecifier))
+		return appendFmtLiteralHex (fmtLiteral, (uint32_t) x, fmtSpecifier [0] == 'X');
+
 	return appendFmtLiteralImpl (fmtLiteral, fmtSpecifier, "d", x);
 }
 
@@ -916,6 +1323,12 @@ appendFmtLiteral_ui32 (
 	uint32_t x
 	)
 {
+	if (!fmtSpecifier)
+		return appendFmtLiteralDec (fmtLiteral, x, false);
+
+	if (isHexFmtSpecifier (fmtSpecifier))
+		return appendFmtLiteralHex (fmtLiteral, x, fmtSpecifier [0] == 'X');
+
 	return appendFmtLiteralImpl (fmtLiteral, fmtSpecifier, "u", x);
 }
 
@@ -927,6 +1340,12 @@ appendFmtLiteral_i64 (
 	int64_t x
 	)
 {
+	if (!fmtSpecifier)
+		return appendFmtLiteralDec (fmtLiteral, x < 0 ? 0 - (uint64_t) x : x, x < 0);
+
+	if (isHexFmtSpecifier (fmtSpecifier))
+		return appendFmtLiteralHex (fmtLiteral, x, fmtSpecifier [0] == 'X');
+
 	return appendFmtLiteralImpl (fmtLiteral, fmtSpecifier, "lld", x);
 }
 
@@ -938,6 +1357,12 @@ appendFmtLiteral_ui64 (
 	uint64_t x
 	)
 {
+	if (!fmtSpecifier)
+		return appendFmtLiteralDec (fmtLiteral, x, false);
+
+	if (isHexFmtSpecifier (fmtSpecifier))
+		return appendFmtLiteralHex (fmtLiteral, x, fmtSpecifier [0] == 'X');
+
 	return appendFmtLiteralImpl (fmtLiteral, fmtSpecifier, "llu", x);
 }
 
@@ -1268,7 +1693,11 @@ JNC_BEGIN_LIB_FUNCTION_MAP (jnc_CoreLib)
 
 	// exceptions
 
+#if (_JNC_OS_POSIX)
+	JNC_MAP_STD_FUNCTION (ct::StdFunc_SetJmp,       ::_setjmp) // don't save signal mask (a syscall per try)
+#else
 	JNC_MAP_STD_FUNCTION (ct::StdFunc_SetJmp,       ::setjmp)
+#endif
 	JNC_MAP_STD_FUNCTION (ct::StdFunc_DynamicThrow, dynamicThrow)
 
 	// runtime checks
@@ -1301,6 +1730,7 @@ JNC_BEGIN_LIB_FUNCTION_MAP (jnc_CoreLib)
 	JNC_MAP_STD_FUNCTION (ct::StdFunc_AppendFmtLiteral_ui64, appendFmtLiteral_ui64)
 	JNC_MAP_STD_FUNCTION (ct::StdFunc_AppendFmtLiteral_f,    appendFmtLiteral_f)
 	JNC_MAP_STD_FUNCTION (ct::StdFunc_AppendFmtLiteral_v,    appendFmtLiteral_v)
+	JNC_MAP_STD_FUNCTION (ct::StdFunc_ReserveFmtLiteral,     reserveFmtLiteral)
 
 	// multicasts
 
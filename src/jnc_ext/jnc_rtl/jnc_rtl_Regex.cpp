@@ -332,6 +332,7 @@ RegexState::writeData (
 	)
 {
 	uchar_t* end = p + length;
+	uchar_t* matchBuffer = (uchar_t*) m_matchBufferPtr.m_p;
 
 	while (p < end)
 	{
@@ -342,7 +343,22 @@ RegexState::writeData (
 
 		m_currentOffset++;
 
-		size_t result = writeChar (c);
+		matchBuffer [m_matchLength++] = c;
+		if (m_matchLength >= m_matchLengthLimit)
+			return RegexResult_Error;
+
+		// hot path: moving into a plain state (not accepting, no capture groups)
+		// only needs the state id updated -- this is where tokenizers spend
+		// most of the time (e.g. inside identifiers, numbers, whitespace runs)
+
+		uintptr_t targetStateId = m_dfa->getTransition (m_stateId, c);
+		if (targetStateId != -1 && m_dfa->isPlainState (targetStateId))
+		{
+			m_stateId = targetStateId;
+			continue;
+		}
+
+		size_t result = processTransition (targetStateId);
 		if (result != RegexResult_Continue)
 			return result;
 	}
@@ -351,13 +367,8 @@ RegexState::writeData (
 }
 
 size_t
-RegexState::writeChar (uchar_t c)
+RegexState::processTransition (uintptr_t targetStateId)
 {
-	((uchar_t*) m_matchBufferPtr.m_p) [m_matchLength++] = c;
-	if (m_matchLength >= m_matchLengthLimit)
-		return RegexResult_Error;
-
-	uintptr_t targetStateId = m_dfa->getTransition (m_stateId, c);
 	if (targetStateId != -1)
 		return gotoState (targetStateId);
 
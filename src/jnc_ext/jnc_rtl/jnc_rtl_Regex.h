@@ -126,7 +126,7 @@ protected:
 		);
 
 	size_t
-	writeChar (uchar_t c);
+	processTransition (uintptr_t targetStateId);
 
 	size_t
 	gotoState (size_t stateId);
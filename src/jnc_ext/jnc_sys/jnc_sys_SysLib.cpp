@@ -16,6 +16,7 @@
 #include "jnc_sys_NotificationEvent.h"
 #include "jnc_sys_Thread.h"
 #include "jnc_sys_Timer.h"
+#include "jnc_sys_ThreadPool.h"
 
 #include "sys_globals.jnc.cpp"
 #include "sys_Lock.jnc.cpp"
@@ -23,6 +24,7 @@
 #include "sys_NotificationEvent.jnc.cpp"
 #include "sys_Thread.jnc.cpp"
 #include "sys_Timer.jnc.cpp"
+#include "sys_ThreadPool.jnc.cpp"
 
 namespace jnc {
 namespace sys {
@@ -231,6 +233,7 @@ JNC_BEGIN_LIB_SOURCE_FILE_TABLE (jnc_SysLib)
 	JNC_LIB_SOURCE_FILE ("sys_NotificationEvent.jnc", g_sys_NotificationEventSrc)
 	JNC_LIB_SOURCE_FILE ("sys_Thread.jnc",  g_sys_ThreadSrc)
 	JNC_LIB_SOURCE_FILE ("sys_Timer.jnc",   g_sys_TimerSrc)
+	JNC_LIB_SOURCE_FILE ("sys_ThreadPool.jnc", g_sys_ThreadPoolSrc)
 
 	JNC_LIB_IMPORT ("sys_globals.jnc")
 JNC_END_LIB_SOURCE_FILE_TABLE ()
@@ -241,6 +244,7 @@ JNC_BEGIN_LIB_OPAQUE_CLASS_TYPE_TABLE (jnc_SysLib)
 	JNC_LIB_OPAQUE_CLASS_TYPE_TABLE_ENTRY (NotificationEvent)
 	JNC_LIB_OPAQUE_CLASS_TYPE_TABLE_ENTRY (Thread)
 	JNC_LIB_OPAQUE_CLASS_TYPE_TABLE_ENTRY (Timer)
+	JNC_LIB_OPAQUE_CLASS_TYPE_TABLE_ENTRY (ThreadPool)
 JNC_END_LIB_OPAQUE_CLASS_TYPE_TABLE ()
 
 JNC_BEGIN_LIB_FUNCTION_MAP (jnc_SysLib)
@@ -260,6 +264,7 @@ JNC_BEGIN_LIB_FUNCTION_MAP (jnc_SysLib)
 	JNC_MAP_TYPE (Event)
 	JNC_MAP_TYPE (Thread)
 	JNC_MAP_TYPE (Timer)
+	JNC_MAP_TYPE (ThreadPool)
 JNC_END_LIB_FUNCTION_MAP ()
 
 //..............................................................................
@@ -0,0 +1,576 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#include "pch.h"
+#include "jnc_sys_ThreadPool.h"
+#include "jnc_sys_SysLib.h"
+
+namespace jnc {
+namespace sys {
+
+//..............................................................................
+
+JNC_DEFINE_OPAQUE_CLASS_TYPE (
+	ThreadPool,
+	"sys.ThreadPool",
+	g_sysLibGuid,
+	SysLibCacheSlot_ThreadPool,
+	ThreadPool,
+	&ThreadPool::markOpaqueGcRoots
+	)
+
+JNC_BEGIN_TYPE_FUNCTION_MAP (ThreadPool)
+	JNC_MAP_CONSTRUCTOR (&jnc::construct <ThreadPool>)
+	JNC_MAP_DESTRUCTOR (&jnc::destruct <ThreadPool>)
+	JNC_MAP_FUNCTION ("start",       &ThreadPool::start)
+	JNC_MAP_FUNCTION ("stop",        &ThreadPool::stop)
+	JNC_MAP_FUNCTION ("enqueue",     &ThreadPool::enqueue)
+	JNC_MAP_FUNCTION ("wait",        &ThreadPool::wait)
+	JNC_MAP_FUNCTION ("parallelFor", &ThreadPool::parallelFor)
+JNC_END_TYPE_FUNCTION_MAP ()
+
+//..............................................................................
+
+ThreadPool::ThreadPool ()
+{
+	m_runtime = getCurrentThreadRuntime ();
+	ASSERT (m_runtime);
+
+	m_threadCount = 0;
+	m_flags = 0;
+	m_nextWorkerIdx = 0;
+	m_pendingTaskCount = 0;
+	m_idleEvent.signal ();
+}
+
+void
+JNC_CDECL
+ThreadPool::markOpaqueGcRoots (jnc::GcHeap* gcHeap)
+{
+	if (!m_runtime) // not constructed yet
+		return;
+
+	size_t count = m_workerArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+	{
+		Worker* worker = m_workerArray [i];
+
+		worker->m_lock.lock ();
+
+		if (worker->m_activeTask)
+			markTask (gcHeap, worker->m_activeTask);
+
+		sl::Iterator <Task> it = worker->m_taskList.getHead ();
+		for (; it; it++)
+			markTask (gcHeap, *it);
+
+		worker->m_lock.unlock ();
+	}
+}
+
+void
+ThreadPool::markTask (
+	jnc::GcHeap* gcHeap,
+	Task* task
+	)
+{
+	FunctionPtr funcPtr = task->m_taskKind == TaskKind_ForRange ?
+		task->m_forGroup->m_funcPtr :
+		task->m_funcPtr;
+
+	if (funcPtr.m_closure)
+		gcHeap->markClass (funcPtr.m_closure->m_box);
+
+	if (task->m_completionFuncPtr.m_closure)
+		gcHeap->markClass (task->m_completionFuncPtr.m_closure->m_box);
+}
+
+bool
+JNC_CDECL
+ThreadPool::start (size_t threadCount)
+{
+	stop ();
+
+	if (!threadCount)
+		threadCount = g::getModule ()->getSystemInfo ()->m_processorCount;
+
+	m_workerArray.setCount (threadCount);
+
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		Worker* worker = AXL_MEM_NEW (Worker);
+		worker->m_pool = this;
+		worker->m_idx = i;
+		worker->m_activeTask = NULL;
+		m_workerArray [i] = worker;
+	}
+
+	m_flags = Flag_Started;
+	m_nextWorkerIdx = 0;
+	m_threadCount = threadCount;
+
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		bool result = m_workerArray [i]->m_thread.start ();
+		if (!result)
+		{
+			stop ();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void
+JNC_CDECL
+ThreadPool::stop ()
+{
+	m_lock.lock ();
+
+	if (!(m_flags & Flag_Started))
+	{
+		m_lock.unlock ();
+		return;
+	}
+
+	m_flags |= Flag_Stopping;
+	m_lock.unlock ();
+
+	size_t count = m_workerArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+		m_workerArray [i]->m_event.signal ();
+
+	if (getCurrentThreadWorker ()) // can't join ourselves; the next stop from outside will
+		return;
+
+	GcHeap* gcHeap = m_runtime->getGcHeap ();
+	ASSERT (gcHeap == getCurrentThreadGcHeap ());
+
+	gcHeap->enterWaitRegion ();
+
+	for (size_t i = 0; i < count; i++)
+		m_workerArray [i]->m_thread.waitAndClose ();
+
+	gcHeap->leaveWaitRegion ();
+
+	for (size_t i = 0; i < count; i++)
+	{
+		cancelTasks (m_workerArray [i]);
+		AXL_MEM_DELETE (m_workerArray [i]);
+	}
+
+	m_workerArray.clear ();
+	m_idleWorkerArray.clear ();
+
+	m_lock.lock ();
+	m_flags = 0;
+	m_pendingTaskCount = 0;
+	m_idleEvent.signal ();
+	m_lock.unlock ();
+
+	m_threadCount = 0;
+}
+
+bool
+JNC_CDECL
+ThreadPool::enqueue (
+	FunctionPtr funcPtr,
+	FunctionPtr completionFuncPtr
+	)
+{
+	if (!funcPtr.m_p)
+	{
+		err::setError (err::SystemErrorCode_InvalidParameter);
+		return false;
+	}
+
+	Task* task = AXL_MEM_NEW (Task);
+	task->m_taskKind = TaskKind_Func;
+	task->m_funcPtr = funcPtr;
+	task->m_completionFuncPtr = completionFuncPtr;
+	task->m_forGroup = NULL;
+	task->m_begin = 0;
+	task->m_end = 0;
+
+	return addTask (task);
+}
+
+bool
+JNC_CDECL
+ThreadPool::wait (uint_t timeout)
+{
+	if (getCurrentThreadWorker ()) // the calling task itself is pending
+		return false;
+
+	GcHeap* gcHeap = m_runtime->getGcHeap ();
+	ASSERT (gcHeap == getCurrentThreadGcHeap ());
+
+	gcHeap->enterWaitRegion ();
+	bool result = m_idleEvent.wait (timeout);
+	gcHeap->leaveWaitRegion ();
+
+	return result;
+}
+
+bool
+JNC_CDECL
+ThreadPool::parallelFor (
+	size_t count,
+	FunctionPtr funcPtr
+	)
+{
+	if (!count)
+		return true;
+
+	if (getCurrentThreadWorker ())
+	{
+		// blocking a worker until other workers pick up the chunks may starve
+		// the pool -- so a nested parallelFor just runs the whole range inline
+
+		for (size_t i = 0; i < count; i++)
+			callVoidFunctionPtr (funcPtr, i);
+
+		return true;
+	}
+
+	size_t threadCount = m_workerArray.getCount ();
+	if (!threadCount)
+	{
+		err::setError (err::SystemErrorCode_InvalidDeviceState);
+		return false;
+	}
+
+	// a few chunks per worker, so that stealing can even out uneven iterations
+
+	size_t chunkCount = AXL_MIN (count, threadCount * 4);
+	size_t chunkSize = count / chunkCount;
+	size_t extraCount = count % chunkCount;
+
+	ForGroup group;
+	group.m_funcPtr = funcPtr;
+	group.m_pendingCount = chunkCount;
+	group.m_isFailed = false;
+
+	bool isQueued = true;
+	size_t begin = 0;
+
+	for (size_t i = 0; i < chunkCount; i++)
+	{
+		Task* task = AXL_MEM_NEW (Task);
+		task->m_taskKind = TaskKind_ForRange;
+		task->m_forGroup = &group;
+		task->m_begin = begin;
+		begin += i < extraCount ? chunkSize + 1 : chunkSize;
+		task->m_end = begin;
+
+		bool result = addTask (task);
+		if (!result) // stopped concurrently; account for the chunks never queued
+		{
+			isQueued = false;
+
+			for (; i < chunkCount; i++)
+				finishForGroupChunk (&group, false);
+
+			break;
+		}
+	}
+
+	GcHeap* gcHeap = m_runtime->getGcHeap ();
+	ASSERT (gcHeap == getCurrentThreadGcHeap ());
+
+	gcHeap->enterWaitRegion ();
+	group.m_completionEvent.wait ();
+	gcHeap->leaveWaitRegion ();
+
+	if (!isQueued) // error is already set by addTask
+		return false;
+
+	if (group.m_isFailed)
+	{
+		err::setError ("parallelFor iteration failed");
+		return false;
+	}
+
+	return true;
+}
+
+ThreadPool::Worker*
+ThreadPool::getCurrentThreadWorker ()
+{
+	Worker* worker = axl::sys::getTlsPtrSlotValue <Worker> ();
+	return worker && worker->m_pool == this ? worker : NULL;
+}
+
+bool
+ThreadPool::addTask (Task* task)
+{
+	Worker* currentWorker = getCurrentThreadWorker ();
+
+	m_lock.lock ();
+
+	if ((m_flags & (Flag_Started | Flag_Stopping)) != Flag_Started)
+	{
+		m_lock.unlock ();
+		AXL_MEM_DELETE (task);
+		err::setError (err::SystemErrorCode_InvalidDeviceState);
+		return false;
+	}
+
+	if (!m_pendingTaskCount++)
+		m_idleEvent.reset ();
+
+	// tasks spawned by tasks go to the local queue; others are spread round-robin
+
+	Worker* worker;
+	if (currentWorker)
+	{
+		worker = currentWorker;
+	}
+	else
+	{
+		worker = m_workerArray [m_nextWorkerIdx];
+		m_nextWorkerIdx = (m_nextWorkerIdx + 1) % m_workerArray.getCount ();
+	}
+
+	Worker* idleWorker = !m_idleWorkerArray.isEmpty () ? m_idleWorkerArray.getBackAndPop () : NULL;
+
+	worker->m_lock.lock ();
+	worker->m_taskList.insertTail (task);
+	worker->m_lock.unlock ();
+
+	m_lock.unlock ();
+
+	if (idleWorker)
+		idleWorker->m_event.signal ();
+	else if (worker != currentWorker)
+		worker->m_event.signal ();
+
+	return true;
+}
+
+ThreadPool::Task*
+ThreadPool::getTask (Worker* worker)
+{
+	// this is only called within an entered call, i.e. while the worker is a
+	// GC mutator -- so no collection can mark in between the steal and
+	// assigning m_activeTask
+
+	worker->m_lock.lock ();
+	Task* task = worker->m_taskList.removeTail ();
+	worker->m_activeTask = task;
+	worker->m_lock.unlock ();
+
+	if (task)
+		return task;
+
+	size_t count = m_workerArray.getCount ();
+	for (size_t i = 1; i < count; i++)
+	{
+		Worker* victim = m_workerArray [(worker->m_idx + i) % count];
+
+		victim->m_lock.lock ();
+		task = victim->m_taskList.removeHead ();
+		victim->m_lock.unlock ();
+
+		if (task)
+		{
+			worker->m_lock.lock ();
+			worker->m_activeTask = task;
+			worker->m_lock.unlock ();
+			return task;
+		}
+	}
+
+	return NULL;
+}
+
+void
+ThreadPool::runTask (Task* task)
+{
+	if (task->m_taskKind == TaskKind_Func)
+	{
+		callVoidFunctionPtr (task->m_funcPtr);
+		return;
+	}
+
+	ForGroup* group = task->m_forGroup;
+	for (size_t i = task->m_begin; i < task->m_end && !group->m_isFailed; i++)
+		callVoidFunctionPtr (group->m_funcPtr, i);
+}
+
+void
+ThreadPool::finishTask (
+	Worker* worker,
+	Task* task,
+	bool result,
+	CallSite* callSite
+	)
+{
+	if (task->m_completionFuncPtr.m_p)
+	{
+		JNC_BEGIN_ENTERED_CALL_SITE (m_runtime, callSite)
+			callVoidFunctionPtr (task->m_completionFuncPtr, result);
+		JNC_END_ENTERED_CALL_SITE ()
+	}
+
+	// unlink the task before signalling its group -- the group lives on the
+	// stack of the parallelFor caller and may be gone right after that
+
+	worker->m_lock.lock ();
+	worker->m_activeTask = NULL;
+	worker->m_lock.unlock ();
+
+	if (task->m_taskKind == TaskKind_ForRange)
+		finishForGroupChunk (task->m_forGroup, result);
+
+	AXL_MEM_DELETE (task);
+	decrementPendingTaskCount ();
+}
+
+void
+ThreadPool::finishForGroupChunk (
+	ForGroup* group,
+	bool result
+	)
+{
+	if (!result)
+		group->m_isFailed = true;
+
+	intptr_t count = axl::sys::atomicDec (&group->m_pendingCount);
+	if (!count)
+		group->m_completionEvent.signal ();
+}
+
+void
+ThreadPool::cancelTasks (Worker* worker)
+{
+	for (;;)
+	{
+		worker->m_lock.lock ();
+		Task* task = worker->m_taskList.removeHead ();
+		worker->m_lock.unlock ();
+
+		if (!task)
+			break;
+
+		if (task->m_taskKind == TaskKind_ForRange)
+			finishForGroupChunk (task->m_forGroup, false);
+
+		AXL_MEM_DELETE (task);
+		decrementPendingTaskCount ();
+	}
+}
+
+void
+ThreadPool::decrementPendingTaskCount ()
+{
+	m_lock.lock ();
+
+	ASSERT (m_pendingTaskCount);
+	if (!--m_pendingTaskCount)
+		m_idleEvent.signal ();
+
+	m_lock.unlock ();
+}
+
+void
+ThreadPool::removeIdleWorker (Worker* worker)
+{
+	m_lock.lock ();
+
+	size_t count = m_idleWorkerArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+		if (m_idleWorkerArray [i] == worker)
+		{
+			m_idleWorkerArray.remove (i);
+			break;
+		}
+
+	m_lock.unlock ();
+}
+
+void
+ThreadPool::workerThreadFunc (Worker* worker)
+{
+	// workers stay within a single call site for their whole life and only
+	// leave the GC wait region for the duration of each task
+
+	CallSite callSite;
+	m_runtime->enterCallSite (&callSite);
+	axl::sys::setTlsPtrSlotValue <Worker> (worker);
+
+	bool isIdle = false;
+
+	for (;;)
+	{
+		Task* volatile task = NULL;
+		bool result;
+
+		JNC_BEGIN_ENTERED_CALL_SITE (m_runtime, &callSite)
+			task = getTask (worker);
+			if (task)
+				runTask (task);
+		JNC_END_ENTERED_CALL_SITE_EX (&result)
+
+		if (task)
+		{
+			if (isIdle)
+			{
+				removeIdleWorker (worker);
+				isIdle = false;
+			}
+
+			finishTask (worker, task, result, &callSite);
+			continue;
+		}
+
+		if (!result) // the runtime is being aborted
+			break;
+
+		if (!isIdle)
+		{
+			// announce the worker as idle first, then re-check the queues --
+			// otherwise a task enqueued in-between could go unnoticed
+
+			m_lock.lock ();
+
+			if (m_flags & Flag_Stopping) // all the queues are drained
+			{
+				m_lock.unlock ();
+				break;
+			}
+
+			m_idleWorkerArray.append (worker);
+			m_lock.unlock ();
+
+			isIdle = true;
+			continue;
+		}
+
+		worker->m_event.wait ();
+		removeIdleWorker (worker); // addTask may have removed it already
+		isIdle = false;
+	}
+
+	if (isIdle)
+		removeIdleWorker (worker);
+
+	cancelTasks (worker);
+
+	axl::sys::setTlsPtrSlotValue <Worker> (NULL);
+	m_runtime->leaveCallSite (&callSite);
+}
+
+//..............................................................................
+
+} // namespace sys
+} // namespace jnc
@@ -0,0 +1,184 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#pragma once
+
+#include "jnc_ExtensionLib.h"
+#include "jnc_CallSite.h"
+
+namespace jnc {
+namespace sys {
+
+JNC_DECLARE_OPAQUE_CLASS_TYPE (ThreadPool)
+
+//..............................................................................
+
+class ThreadPool: public IfaceHdr
+{
+protected:
+	enum Flag
+	{
+		Flag_Started  = 0x01,
+		Flag_Stopping = 0x02,
+	};
+
+	enum TaskKind
+	{
+		TaskKind_Func,
+		TaskKind_ForRange,
+	};
+
+	// lives on the stack of the thread calling parallelFor
+
+	struct ForGroup
+	{
+		FunctionPtr m_funcPtr;
+		volatile size_t m_pendingCount;
+		volatile bool m_isFailed;
+		axl::sys::Event m_completionEvent;
+	};
+
+	struct Task: sl::ListLink
+	{
+		TaskKind m_taskKind;
+		FunctionPtr m_funcPtr;
+		FunctionPtr m_completionFuncPtr;
+		ForGroup* m_forGroup;
+		size_t m_begin;
+		size_t m_end;
+	};
+
+	struct Worker
+	{
+		class ThreadImpl: public axl::sys::ThreadImpl <ThreadImpl>
+		{
+		public:
+			void
+			threadFunc ()
+			{
+				Worker* worker = containerof (this, Worker, m_thread);
+				worker->m_pool->workerThreadFunc (worker);
+			}
+		};
+
+		ThreadPool* m_pool;
+		size_t m_idx;
+		ThreadImpl m_thread;
+		axl::sys::Event m_event;
+		axl::sys::Lock m_lock;
+		sl::List <Task> m_taskList; // the owner pops from the tail, others steal from the head
+		Task* m_activeTask;
+	};
+
+public:
+	size_t m_threadCount;
+
+protected:
+	Runtime* m_runtime;
+
+	axl::sys::Lock m_lock;
+	uint_t m_flags;
+	sl::Array <Worker*> m_workerArray;
+	sl::Array <Worker*> m_idleWorkerArray;
+	size_t m_nextWorkerIdx;
+	size_t m_pendingTaskCount;
+	axl::sys::NotificationEvent m_idleEvent;
+
+public:
+	ThreadPool ();
+
+	~ThreadPool ()
+	{
+		stop ();
+	}
+
+	void
+	JNC_CDECL
+	markOpaqueGcRoots (jnc::GcHeap* gcHeap);
+
+	bool
+	JNC_CDECL
+	start (size_t threadCount);
+
+	void
+	JNC_CDECL
+	stop ();
+
+	bool
+	JNC_CDECL
+	enqueue (
+		FunctionPtr funcPtr,
+		FunctionPtr completionFuncPtr
+		);
+
+	bool
+	JNC_CDECL
+	wait (uint_t timeout);
+
+	bool
+	JNC_CDECL
+	parallelFor (
+		size_t count,
+		FunctionPtr funcPtr
+		);
+
+protected:
+	static
+	void
+	markTask (
+		jnc::GcHeap* gcHeap,
+		Task* task
+		);
+
+	static
+	void
+	finishForGroupChunk (
+		ForGroup* group,
+		bool result
+		);
+
+	Worker*
+	getCurrentThreadWorker ();
+
+	bool
+	addTask (Task* task);
+
+	Task*
+	getTask (Worker* worker);
+
+	void
+	runTask (Task* task);
+
+	void
+	finishTask (
+		Worker* worker,
+		Task* task,
+		bool result,
+		CallSite* callSite
+		);
+
+	void
+	cancelTasks (Worker* worker);
+
+	void
+	decrementPendingTaskCount ();
+
+	void
+	removeIdleWorker (Worker* worker);
+
+	void
+	workerThreadFunc (Worker* worker);
+};
+
+//..............................................................................
+
+} // namespace sys
+} // namespace jnc
@@ -36,6 +36,21 @@ JNC_END_TYPE_FUNCTION_MAP ()
 
 //..............................................................................
 
+Timer::Timer ()
+{
+	m_runtime = getCurrentThreadRuntime ();
+	ASSERT (m_runtime);
+
+	m_timerService = sl::getSimpleSingleton <TimerServiceMgr> ()->addRef (m_runtime);
+	m_timerList = NULL;
+}
+
+Timer::~Timer ()
+{
+	stop ();
+	sl::getSimpleSingleton <TimerServiceMgr> ()->release (m_timerService);
+}
+
 bool
 JNC_CDECL
 Timer::start (
@@ -51,9 +66,8 @@ Timer::start (
 	m_timerFuncPtr = ptr;
 	m_dueTime = dueTime;
 	m_interval = interval;
-	m_stopEvent.reset ();
 
-	result = m_thread.start ();
+	result = m_timerService->startTimer (this);
 	if (!result)
 	{
 		m_timerFuncPtr = g_nullFunctionPtr;
@@ -67,50 +81,401 @@ void
 JNC_CDECL
 Timer::stop ()
 {
-	m_stopEvent.signal ();
+	m_timerService->stopTimer (this);
+
+	m_timerFuncPtr = g_nullFunctionPtr;
+	m_dueTime = 0;
+	m_interval = 0;
+}
+
+//..............................................................................
+
+TimerService::TimerService (Runtime* runtime)
+{
+	m_runtime = runtime;
+	m_refCount = 0;
+	m_flags = 0;
+	m_timerCount = 0;
+	m_currentTick = getCurrentTick ();
+	m_wakeTick = -1;
+	m_dispatchedTimer = NULL;
+
+	memset (m_levelTimerCount, 0, sizeof (m_levelTimerCount));
+}
+
+TimerService::~TimerService ()
+{
+	requestStop ();
+	m_thread.waitAndClose ();
+}
+
+void
+TimerService::requestStop ()
+{
+	m_lock.lock ();
+	m_flags |= Flag_Stop;
+	m_lock.unlock ();
+
+	m_event.signal ();
+}
 
-	if (m_thread.getThreadId () != axl::sys::getCurrentThreadId ())
+bool
+TimerService::startTimer (Timer* timer)
+{
+	m_lock.lock ();
+
+	if (!(m_flags & Flag_Started))
 	{
-		GcHeap* gcHeap = m_runtime->getGcHeap ();
-		ASSERT (gcHeap == getCurrentThreadGcHeap ());
+		bool result = m_thread.start ();
+		if (!result)
+		{
+			m_lock.unlock ();
+			return false;
+		}
+
+		m_flags |= Flag_Started;
+	}
+
+	if (!m_timerCount) // the wheel is not being advanced while empty
+	{
+		uint64_t tick = getCurrentTick ();
+		if (tick > m_currentTick)
+			m_currentTick = tick;
+	}
+
+	timer->m_dueTick = timer->m_dueTime / 10000;
+	insertTimer_l (timer);
+
+	if (timer->m_dueTick < m_wakeTick)
+		m_event.signal ();
+
+	m_lock.unlock ();
+	return true;
+}
+
+void
+TimerService::stopTimer (Timer* timer)
+{
+	m_lock.lock ();
+
+	if (timer->m_timerList)
+		removeTimer_l (timer);
+
+	if (m_dispatchedTimer != timer || isServiceThread ())
+	{
+		m_lock.unlock ();
+		return;
+	}
+
+	// the timer function is running right now -- wait for it to return
+
+	GcHeap* gcHeap = timer->m_runtime->getGcHeap ();
+	ASSERT (gcHeap == getCurrentThreadGcHeap ());
+
+	while (m_dispatchedTimer == timer)
+	{
+		m_lock.unlock ();
 
 		gcHeap->enterWaitRegion ();
-		m_thread.waitAndClose ();
+		m_dispatchEvent.wait ();
 		gcHeap->leaveWaitRegion ();
+
+		m_lock.lock ();
 	}
 
-	m_timerFuncPtr = g_nullFunctionPtr;
-	m_dueTime = 0;
-	m_interval = 0;
+	m_lock.unlock ();
 }
 
 void
-Timer::threadFunc ()
+TimerService::insertTimer_l (Timer* timer)
 {
-	bool result;
-
-	uint64_t timestamp = axl::sys::getTimestamp ();
-	if (m_dueTime > timestamp)
+	uint64_t dueTick = timer->m_dueTick;
+	if (dueTick <= m_currentTick)
 	{
-		uint_t delay = (uint_t) ((m_dueTime - timestamp) / 10000);
-		result = m_stopEvent.wait (delay);
-		if (result)
-			return;
+		m_expiredList.insertTail (timer);
+		timer->m_timerList = &m_expiredList;
+		return;
 	}
 
-	callVoidFunctionPtr (m_runtime, m_timerFuncPtr);
+	uint64_t delta = dueTick - m_currentTick;
+
+	size_t level = 0;
+	while (level < LevelCount - 1 && delta >> ((level + 1) * SlotBitCount))
+		level++;
+
+	if (delta >> (LevelCount * SlotBitCount)) // beyond the wheel; gets re-inserted on cascade
+		dueTick = m_currentTick + ((uint64_t) 1 << (LevelCount * SlotBitCount)) - 1;
+
+	size_t slot = (size_t) (dueTick >> (level * SlotBitCount)) & SlotMask;
+	TimerList* list = &m_wheel [level] [slot];
+	list->insertTail (timer);
+	timer->m_timerList = list;
+	m_levelTimerCount [level]++;
+	m_timerCount++;
+}
+
+void
+TimerService::removeTimer_l (Timer* timer)
+{
+	TimerList* list = timer->m_timerList;
+	list->remove (timer);
+	timer->m_timerList = NULL;
 
-	if (!m_interval || m_interval == -1)
+	if (list == &m_expiredList)
 		return;
 
+	size_t level = (list - m_wheel [0]) / SlotCount;
+	m_levelTimerCount [level]--;
+	m_timerCount--;
+}
+
+void
+TimerService::cascade_l (size_t level)
+{
+	size_t slot = (size_t) (m_currentTick >> (level * SlotBitCount)) & SlotMask;
+	TimerList* list = &m_wheel [level] [slot];
+
+	while (!list->isEmpty ())
+	{
+		Timer* timer = list->removeHead ();
+		m_levelTimerCount [level]--;
+		m_timerCount--;
+
+		insertTimer_l (timer);
+	}
+
+	if (!slot && level + 1 < LevelCount)
+		cascade_l (level + 1);
+}
+
+void
+TimerService::advance_l (uint64_t tick)
+{
+	while (m_currentTick < tick)
+	{
+		if (!m_timerCount)
+		{
+			m_currentTick = tick;
+			break;
+		}
+
+		if (m_levelTimerCount [0])
+		{
+			m_currentTick++;
+		}
+		else // nothing in the innermost level -- skip to the next cascade
+		{
+			uint64_t nextTick = (m_currentTick | SlotMask) + 1;
+			if (nextTick > tick)
+			{
+				m_currentTick = tick;
+				break;
+			}
+
+			m_currentTick = nextTick;
+		}
+
+		size_t slot = (size_t) m_currentTick & SlotMask;
+		if (!slot)
+			cascade_l (1);
+
+		TimerList* list = &m_wheel [0] [slot];
+		m_levelTimerCount [0] -= list->getCount ();
+		m_timerCount -= list->getCount ();
+
+		while (!list->isEmpty ())
+		{
+			Timer* timer = list->removeHead ();
+			m_expiredList.insertTail (timer);
+			timer->m_timerList = &m_expiredList;
+		}
+	}
+}
+
+uint64_t
+TimerService::getWakeTick_l ()
+{
+	if (!m_expiredList.isEmpty ())
+		return m_currentTick;
+
+	if (m_levelTimerCount [0])
+	{
+		uint64_t tick = m_currentTick + 1;
+		for (; tick & SlotMask; tick++)
+			if (!m_wheel [0] [(size_t) tick & SlotMask].isEmpty ())
+				return tick;
+
+		return tick; // the next cascade
+	}
+
+	for (size_t level = 1; level < LevelCount; level++)
+		if (m_levelTimerCount [level])
+		{
+			size_t shift = level * SlotBitCount;
+			return ((m_currentTick >> shift) + 1) << shift;
+		}
+
+	return -1;
+}
+
+void
+TimerService::threadFunc ()
+{
+	// a call site is entered lazily and kept across a batch of expired timers;
+	// it's left before going to sleep, so that the runtime never waits for
+	// this thread on shutdown
+
+	CallSite callSite;
+	bool isCallSiteEntered = false;
+
 	for (;;)
 	{
-		result = m_stopEvent.wait (m_interval);
-		if (result)
+		m_lock.lock ();
+
+		if (m_flags & Flag_Stop)
+		{
+			m_lock.unlock ();
 			break;
+		}
+
+		advance_l (getCurrentTick ());
+
+		Timer* timer = m_expiredList.removeHead ();
+		if (!timer)
+		{
+			uint64_t wakeTick = getWakeTick_l ();
+			m_wakeTick = wakeTick;
+			m_lock.unlock ();
+
+			if (isCallSiteEntered)
+			{
+				m_runtime->leaveCallSite (&callSite);
+				isCallSiteEntered = false;
+			}
+
+			uint_t timeout = -1;
+			if (wakeTick != (uint64_t) -1)
+			{
+				uint64_t tick = getCurrentTick ();
+				timeout = wakeTick <= tick ? 0 : (uint_t) AXL_MIN (wakeTick - tick, (uint64_t) 0x7fffffff);
+			}
+
+			m_event.wait (timeout);
+			continue;
+		}
+
+		timer->m_timerList = NULL;
+
+		if (timer->m_interval && timer->m_interval != -1)
+		{
+			// re-arm right away, so a slow timer function doesn't shift the
+			// period; missed periods are skipped rather than fired in a burst
+
+			timer->m_dueTick += timer->m_interval;
+			if (timer->m_dueTick <= m_currentTick)
+				timer->m_dueTick = m_currentTick + timer->m_interval;
+
+			insertTimer_l (timer);
+		}
+
+		m_dispatchedTimer = timer;
+		m_dispatchEvent.reset ();
+		m_lock.unlock ();
 
-		callVoidFunctionPtr (m_runtime, m_timerFuncPtr);
+		if (!isCallSiteEntered)
+		{
+			m_runtime->enterCallSite (&callSite);
+			isCallSiteEntered = true;
+		}
+
+		JNC_BEGIN_ENTERED_CALL_SITE (m_runtime, &callSite)
+			callVoidFunctionPtr (timer->m_timerFuncPtr);
+		JNC_END_ENTERED_CALL_SITE ()
+
+		m_lock.lock ();
+		m_dispatchedTimer = NULL;
+		m_dispatchEvent.signal ();
+		m_lock.unlock ();
 	}
+
+	if (isCallSiteEntered)
+		m_runtime->leaveCallSite (&callSite);
+}
+
+//..............................................................................
+
+TimerServiceMgr::~TimerServiceMgr ()
+{
+	sl::HashTableIterator <Runtime*, TimerService*> it = m_serviceMap.getHead ();
+	for (; it; it++)
+		AXL_MEM_DELETE (it->m_value);
+
+	size_t count = m_zombieArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+		AXL_MEM_DELETE (m_zombieArray [i]);
+}
+
+TimerService*
+TimerServiceMgr::addRef (Runtime* runtime)
+{
+	m_lock.lock ();
+
+	sl::HashTableIterator <Runtime*, TimerService*> it = m_serviceMap.visit (runtime);
+	if (!it->m_value)
+		it->m_value = AXL_MEM_NEW_ARGS (TimerService, (runtime));
+
+	TimerService* service = it->m_value;
+	service->m_refCount++;
+
+	m_lock.unlock ();
+	return service;
+}
+
+void
+TimerServiceMgr::release (TimerService* service)
+{
+	m_lock.lock ();
+
+	ASSERT (service->m_refCount);
+	if (--service->m_refCount)
+	{
+		m_lock.unlock ();
+		return;
+	}
+
+	m_serviceMap.eraseKey (service->m_runtime);
+
+	if (service->isServiceThread ())
+	{
+		// the last timer is destroyed from a timer function -- the thread
+		// can't join itself, so it's only told to stop and joined later
+
+		service->requestStop ();
+		m_zombieArray.append (service);
+		m_lock.unlock ();
+		return;
+	}
+
+	sl::Array <TimerService*> zombieArray = m_zombieArray;
+	m_zombieArray.clear ();
+	m_lock.unlock ();
+
+	// the service thread may be inside a timer function, i.e. it may be a
+	// mutator of this runtime -- collections must not wait for this thread
+	// while it's joining
+
+	GcHeap* gcHeap = getCurrentThreadGcHeap ();
+	if (gcHeap)
+		gcHeap->enterWaitRegion ();
+
+	AXL_MEM_DELETE (service);
+
+	size_t count = zombieArray.getCount ();
+	for (size_t i = 0; i < count; i++)
+		AXL_MEM_DELETE (zombieArray [i]);
+
+	if (gcHeap)
+		gcHeap->leaveWaitRegion ();
 }
 
 //..............................................................................
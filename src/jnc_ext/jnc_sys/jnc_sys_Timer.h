@@ -19,42 +19,45 @@ namespace sys {
 
 JNC_DECLARE_OPAQUE_CLASS_TYPE (Timer)
 
+class Timer;
+class TimerService;
+
+//..............................................................................
+
+class GetTimerLink
+{
+public:
+	sl::ListLink*
+	operator () (Timer* timer);
+};
+
+typedef sl::AuxList <Timer, GetTimerLink> TimerList;
+
 //..............................................................................
 
 class Timer: public IfaceHdr
 {
-protected:
-	class ThreadImpl: public axl::sys::ThreadImpl <ThreadImpl>
-	{
-	public:
-		void
-		threadFunc ()
-		{
-			containerof (this, Timer, m_thread)->threadFunc ();
-		}
-	};
+	friend class GetTimerLink;
+	friend class TimerService;
 
 public:
 	FunctionPtr m_timerFuncPtr;
 
 protected:
 	Runtime* m_runtime;
-	ThreadImpl m_thread;
-	axl::sys::Event m_stopEvent;
+	TimerService* m_timerService;
 	uint64_t m_dueTime;
 	uint_t m_interval;
 
-public:
-	Timer ()
-	{
-		m_runtime = getCurrentThreadRuntime ();
-		ASSERT (m_runtime);
-	}
+	// guarded by the TimerService lock
 
-	~Timer ()
-	{
-		stop ();
-	}
+	sl::ListLink m_link;
+	TimerList* m_timerList; // wheel slot or expired list; NULL if not armed
+	uint64_t m_dueTick;
+
+public:
+	Timer ();
+	~Timer ();
 
 	bool
 	JNC_CDECL
@@ -67,12 +70,138 @@ public:
 	void
 	JNC_CDECL
 	stop ();
+};
+
+inline
+sl::ListLink*
+GetTimerLink::operator () (Timer* timer)
+{
+	return &timer->m_link;
+}
+
+//..............................................................................
+
+// a single thread serving all sys.Timer objects of one runtime with a
+// hierarchical timer wheel: starting and stopping a timer is O(1), expired
+// timers are dispatched in batches
+
+class TimerService
+{
+	friend class TimerServiceMgr;
 
 protected:
+	enum
+	{
+		LevelCount   = 4,
+		SlotBitCount = 8,
+		SlotCount    = 1 << SlotBitCount,
+		SlotMask     = SlotCount - 1,
+	};
+
+	enum Flag
+	{
+		Flag_Started = 0x01,
+		Flag_Stop    = 0x02,
+	};
+
+	class ThreadImpl: public axl::sys::ThreadImpl <ThreadImpl>
+	{
+	public:
+		void
+		threadFunc ()
+		{
+			containerof (this, TimerService, m_thread)->threadFunc ();
+		}
+	};
+
+protected:
+	Runtime* m_runtime;
+	size_t m_refCount; // guarded by the TimerServiceMgr lock
+
+	ThreadImpl m_thread;
+	axl::sys::Lock m_lock;
+	axl::sys::Event m_event;
+	axl::sys::NotificationEvent m_dispatchEvent;
+	uint_t m_flags;
+
+	TimerList m_wheel [LevelCount] [SlotCount];
+	size_t m_levelTimerCount [LevelCount];
+	size_t m_timerCount;
+	TimerList m_expiredList;
+	uint64_t m_currentTick; // in milliseconds
+	uint64_t m_wakeTick;
+	Timer* m_dispatchedTimer;
+
+public:
+	TimerService (Runtime* runtime);
+	~TimerService ();
+
+	bool
+	startTimer (Timer* timer);
+
+	void
+	stopTimer (Timer* timer);
+
+protected:
+	bool
+	isServiceThread ()
+	{
+		return m_thread.getThreadId () == axl::sys::getCurrentThreadId ();
+	}
+
+	void
+	requestStop ();
+
+	static
+	uint64_t
+	getCurrentTick ()
+	{
+		return axl::sys::getTimestamp () / 10000;
+	}
+
+	void
+	insertTimer_l (Timer* timer);
+
+	void
+	removeTimer_l (Timer* timer);
+
+	void
+	cascade_l (size_t level);
+
+	void
+	advance_l (uint64_t tick);
+
+	uint64_t
+	getWakeTick_l ();
+
 	void
 	threadFunc ();
 };
 
+//..............................................................................
+
+// one TimerService per runtime, referenced by every constructed sys.Timer of
+// this runtime; the service and its thread go away with the last timer
+
+class TimerServiceMgr
+{
+protected:
+	typedef sl::HashTable <Runtime*, TimerService*, sl::HashId <Runtime*> > ServiceMap;
+
+protected:
+	axl::sys::Lock m_lock;
+	ServiceMap m_serviceMap;
+	sl::Array <TimerService*> m_zombieArray; // released on their own threads, not joined yet
+
+public:
+	~TimerServiceMgr ();
+
+	TimerService*
+	addRef (Runtime* runtime);
+
+	void
+	release (TimerService* service);
+};
 
 //..............................................................................
 
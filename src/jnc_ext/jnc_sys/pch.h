@@ -11,10 +11,13 @@
 
 #pragma once
 
+#include "axl_sl_Array.h"
 #include "axl_sl_Construct.h"
+#include "axl_sl_HashTable.h"
 #include "axl_sys_Event.h"
 #include "axl_sys_Thread.h"
 #include "axl_sys_Time.h"
+#include "axl_sys_TlsSlot.h"
 #include "axl_g_Module.h"
 
 using namespace axl;
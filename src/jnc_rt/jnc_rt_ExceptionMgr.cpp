@@ -92,7 +92,12 @@ ExceptionMgr::signalHandler (
 	else
 	{
 		AXL_TODO ("add extra variables to the SJLJ frame to store error information");
-		longjmp (tlsVariableTable->m_sjljFrame->m_jmpBuf, -1);
+
+		// SJLJ frames are set up with _setjmp (no signal mask saved), so
+		// restore the pre-signal mask explicitly before jumping out of the handler
+
+		pthread_sigmask (SIG_SETMASK, &((ucontext_t*) context)->uc_sigmask, NULL);
+		_longjmp (tlsVariableTable->m_sjljFrame->m_jmpBuf, -1);
 		ASSERT (false);
 	}
 }
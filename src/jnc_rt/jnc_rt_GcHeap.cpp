@@ -877,7 +877,7 @@ GcHeap::enterWaitRegion ()
 }
 
 void
-GcHeap::leaveWaitRegion ()
+GcHeap::leaveWaitRegion (bool canAbortThrow)
 {
 	GcMutatorThread* thread = getCurrentGcMutatorThread ();
 	ASSERT (thread && thread->m_waitRegionLevel);
@@ -898,7 +898,7 @@ GcHeap::leaveWaitRegion ()
 	bool isAbort = (m_flags & Flag_Abort) != 0;
 	m_lock.unlock ();
 
-	if (isAbort)
+	if (isAbort && canAbortThrow)
 		abortThrow ();
 }
 
@@ -270,7 +270,7 @@ public:
 	enterWaitRegion ();
 
 	void
-	leaveWaitRegion ();
+	leaveWaitRegion (bool canAbortThrow = true);
 
 	void
 	enterNoCollectRegion ();
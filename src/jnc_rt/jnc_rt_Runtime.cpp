@@ -39,14 +39,39 @@ Runtime::setStackSizeLimit (size_t sizeLimit)
 	}
 
 	m_stackSizeLimit = sizeLimit;
+
+	// prologues compare against the limit cached in TLS -- update running threads, too
+
+	m_lock.lock ();
+
+	sl::Iterator <Tls, GetTlsLink> it = m_tlsList.getHead ();
+	for (; it; it++)
+		updateStackLimit (*it);
+
+	m_lock.unlock ();
 	return true;
 }
 
+void
+Runtime::updateStackLimit (Tls* tls)
+{
+	TlsVariableTable* tlsVariableTable = (TlsVariableTable*) (tls + 1);
+	tlsVariableTable->m_stackLimit = (size_t) tls->m_stackEpoch > m_stackSizeLimit ?
+		(char*) tls->m_stackEpoch - m_stackSizeLimit :
+		NULL;
+}
+
 bool
 Runtime::startup (ct::Module* module)
 {
 	shutdown ();
 
+	if (!module->attachRuntime ())
+	{
+		err::setError ("module is already running in another runtime");
+		return false;
+	}
+
 	m_tlsSize = module->m_variableMgr.getTlsStructType ()->getSize ();
 	m_module = module;
 	m_state = State_Running;
@@ -89,6 +114,7 @@ Runtime::shutdown ()
 
 	ASSERT (m_tlsList.isEmpty ());
 	m_gcHeap.finalizeShutdown ();
+	m_module->detachRuntime ();
 
 	m_state = State_Idle;
 }
@@ -159,6 +185,7 @@ Runtime::initializeCallSite (jnc_CallSite* callSite)
 	TlsVariableTable* tlsVariableTable = (TlsVariableTable*) (tls + 1);
 
 	tlsVariableTable->m_gcShadowStackTop = &callSite->m_gcShadowStackDynamicFrame;
+	updateStackLimit (tls);
 
 	sys::setTlsPtrSlotValue <Tls> (tls);
 
@@ -234,6 +261,66 @@ Runtime::uninitializeCallSite (jnc_CallSite* callSite)
 	AXL_MEM_DELETE (tls);
 }
 
+void
+Runtime::enterCallSite (jnc_CallSite* callSite)
+{
+	// the thread stays registered with the GC heap, but parked in a wait
+	// region -- collections must not wait for it between entered calls
+
+	initializeCallSite (callSite);
+	m_gcHeap.enterWaitRegion ();
+}
+
+void
+Runtime::leaveCallSite (jnc_CallSite* callSite)
+{
+	m_gcHeap.leaveWaitRegion (false); // no sjlj frame to throw to here
+	callSite->m_result = true;
+	uninitializeCallSite (callSite);
+}
+
+void
+Runtime::beginEnteredCall (jnc_CallSite* callSite)
+{
+	ASSERT (
+		sys::getTlsPtrSlotValue <Tls> () &&
+		sys::getTlsPtrSlotValue <Tls> ()->m_runtime == this
+		);
+
+	m_gcHeap.leaveWaitRegion (); // throws if the runtime is being aborted
+}
+
+void
+Runtime::endEnteredCall (
+	jnc_CallSite* callSite,
+	bool result
+	)
+{
+	Tls* tls = sys::getTlsPtrSlotValue <Tls> ();
+	ASSERT (tls && tls->m_runtime == this);
+
+	if (!result)
+	{
+		// restore the state right after enterCallSite
+
+		GcShadowStackFrame* prevGcShadowStackTop = callSite->m_gcShadowStackDynamicFrame.m_prev;
+		TlsVariableTable* tlsVariableTable = (TlsVariableTable*) (tls + 1);
+
+		tls->m_initializeLevel = callSite->m_initializeLevel + 1;
+		tls->m_gcMutatorThread.m_noCollectRegionLevel = callSite->m_noCollectRegionLevel;
+		tls->m_gcMutatorThread.m_waitRegionLevel = callSite->m_waitRegionLevel;
+		tlsVariableTable->m_gcShadowStackTop =
+			prevGcShadowStackTop && prevGcShadowStackTop->m_map->getMapKind () == ct::GcShadowStackFrameMapKind_Dynamic ?
+				prevGcShadowStackTop :
+				&callSite->m_gcShadowStackDynamicFrame;
+	}
+
+	// boxes allocated by the host during this call must not outlive it
+
+	((GcShadowStackFrameMap*) &callSite->m_gcShadowStackDynamicFrameMap)->clearBoxes ();
+	m_gcHeap.enterWaitRegion ();
+}
+
 void
 Runtime::checkStackOverflow ()
 {
@@ -284,7 +371,11 @@ Runtime::dynamicThrow ()
 		pBuffer->Frame = 0; // prevent unwinding -- it doesn't work with the LLVM MCJIT-generated code
 #endif
 
+#if (_JNC_OS_POSIX)
+		_longjmp (tlsVariableTable->m_sjljFrame->m_jmpBuf, -1);
+#else
 		longjmp (tlsVariableTable->m_sjljFrame->m_jmpBuf, -1);
+#endif
 	}
 	else
 	{
@@ -292,7 +383,12 @@ Runtime::dynamicThrow ()
 		TRACE ("-- WARNING: jump to external SJLJ frame: %p\n", frame);
 
 		ASSERT (frame);
+
+#if (_JNC_OS_POSIX)
+		_longjmp (frame->m_jmpBuf, -1);
+#else
 		longjmp (frame->m_jmpBuf, -1);
+#endif
 	}
 
 	ASSERT (false);
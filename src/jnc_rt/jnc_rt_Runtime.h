@@ -101,6 +101,21 @@ public:
 	void
 	uninitializeCallSite (jnc_CallSite* callSite);
 
+	void
+	enterCallSite (jnc_CallSite* callSite);
+
+	void
+	leaveCallSite (jnc_CallSite* callSite);
+
+	void
+	beginEnteredCall (jnc_CallSite* callSite);
+
+	void
+	endEnteredCall (
+		jnc_CallSite* callSite,
+		bool result
+		);
+
 	void
 	checkStackOverflow ();
 
@@ -110,6 +125,10 @@ public:
 	static
 	void
 	dynamicThrow ();
+
+protected:
+	void
+	updateStackLimit (Tls* tls);
 };
 
 // . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . . .
@@ -0,0 +1,118 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#include "pch.h"
+#include "test.h"
+
+//..............................................................................
+
+size_t g_failureCount = 0;
+
+void
+failTest (
+	const char* expression,
+	const char* fileName,
+	int line
+	)
+{
+	printf ("  FAILED: %s (%s:%d)\n", expression, fileName, line);
+	g_failureCount++;
+}
+
+bool
+compileModule (
+	jnc::Module* module,
+	const char* fileName,
+	uint_t compileFlags
+	)
+{
+	module->initialize ("jnc_test_host", compileFlags);
+	module->addStaticLib (jnc::StdLib_getLib ());
+	module->addStaticLib (jnc::SysLib_getLib ());
+
+	bool result =
+		module->parseFile (fileName) &&
+		module->parseImports () &&
+		module->compile () &&
+		module->jit ();
+
+	if (!result)
+		printf ("  error: %s\n", err::getLastErrorDescription ().sz ());
+
+	return result;
+}
+
+jnc::Function*
+findFunction (
+	jnc::Module* module,
+	const char* name
+	)
+{
+	jnc::Function* function = module->getGlobalNamespace ()->getNamespace ()->findFunction (name);
+	if (!function)
+		printf ("  error: %s\n", err::getLastErrorDescription ().sz ());
+
+	return function;
+}
+
+//..............................................................................
+
+#if (_JNC_OS_WIN)
+int
+wmain (
+	int argc,
+	wchar_t* argv []
+	)
+#else
+int
+main (
+	int argc,
+	char* argv []
+	)
+#endif
+{
+#if _AXL_OS_POSIX
+	setvbuf (stdout, NULL, _IOLBF, 1024);
+#endif
+
+	if (argc < 2)
+	{
+		printf ("usage: jnc_test_host <script.jnc>\n");
+		return -1;
+	}
+
+#if (_JNC_OS_WIN)
+	sl::String sourceFileName = argv [1]; // utf16 -> utf8
+#else
+	const char* sourceFileName = argv [1];
+#endif
+
+	g::getModule ()->setTag ("jnc_test_host");
+	jnc::initialize ("jnc_dll:jnc_test_host");
+	jnc::setErrorRouter (err::getErrorMgr ());
+	lex::registerParseErrorProvider ();
+
+	for (size_t i = 0; i < g_testCount; i++)
+	{
+		size_t failureCount = g_failureCount;
+
+		printf ("Running %s...\n", g_testTable [i].m_name);
+		g_testTable [i].m_func (sourceFileName);
+
+		if (g_failureCount == failureCount)
+			printf ("  OK\n");
+	}
+
+	printf ("Done: %d failure(s).\n", (int) g_failureCount);
+	return g_failureCount ? -1 : 0;
+}
+
+//..............................................................................
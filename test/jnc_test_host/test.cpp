@@ -0,0 +1,384 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#include "pch.h"
+#include "test.h"
+
+//..............................................................................
+
+// prologues compare against a stack limit cached in the thread's TLS block;
+// changing the limit must also affect threads which are already running
+
+void
+testStackSizeLimit (const char* fileName)
+{
+	jnc::AutoModule module;
+	jnc::AutoRuntime runtime;
+
+	bool result = compileModule (module, fileName) && runtime->startup (module);
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	jnc::Function* recurse = findFunction (module, "recurse");
+	TEST_CHECK (recurse);
+	if (!recurse)
+		return;
+
+	JNC_BEGIN_CALL_SITE (runtime)
+
+	int retval = 0;
+	result = jnc::callFunction (runtime, recurse, &retval, 200);
+	TEST_CHECK (result && retval == 200);
+
+	// 200 frames with a 1K buffer each don't fit into the minimal limit
+
+	runtime->setStackSizeLimit (jnc::RuntimeDef_MinStackSizeLimit);
+	result = jnc::callFunction (runtime, recurse, &retval, 200);
+	TEST_CHECK (!result);
+
+	runtime->setStackSizeLimit (jnc::RuntimeDef_StackSizeLimit);
+	result = jnc::callFunction (runtime, recurse, &retval, 200);
+	TEST_CHECK (result && retval == 200);
+
+	JNC_CALL_SITE_CATCH ()
+
+	TEST_CHECK (false);
+
+	JNC_END_CALL_SITE ()
+
+	runtime->shutdown ();
+}
+
+//..............................................................................
+
+// constant-capture closures are cached per site: only the first evaluation
+// allocates, and every later one must reuse the same object
+
+static
+bool
+callConstClosure (
+	jnc::Runtime* runtime,
+	jnc::Function* function,
+	size_t* allocSize
+	)
+{
+	jnc::GcStats stats;
+	runtime->getGcHeap ()->getStats (&stats);
+	size_t prevTotalAllocSize = stats.m_totalAllocSize;
+
+	int retval = 0;
+	bool result = jnc::callFunction (runtime, function, &retval, 5);
+
+	runtime->getGcHeap ()->getStats (&stats);
+	*allocSize = stats.m_totalAllocSize - prevTotalAllocSize;
+	return result && retval == 15;
+}
+
+void
+testClosureIdentity (const char* fileName)
+{
+	jnc::AutoModule module;
+	jnc::AutoRuntime runtime;
+
+	bool result = compileModule (module, fileName) && runtime->startup (module);
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	jnc::Function* function = findFunction (module, "callConstClosure");
+	TEST_CHECK (function);
+	if (!function)
+		return;
+
+	size_t allocSize;
+	result = callConstClosure (runtime, function, &allocSize);
+	TEST_CHECK (result && allocSize);
+
+	for (size_t i = 0; i < 10; i++)
+	{
+		result = callConstClosure (runtime, function, &allocSize);
+		TEST_CHECK (result && !allocSize);
+	}
+
+	runtime->shutdown ();
+}
+
+// cached closures die with the runtime; after a restart the site must build
+// a new one rather than pick up the dangling pointer
+
+void
+testClosureCacheRestart (const char* fileName)
+{
+	jnc::AutoModule module;
+	jnc::AutoRuntime runtime;
+
+	bool result = compileModule (module, fileName);
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	jnc::Function* function = findFunction (module, "callConstClosure");
+	TEST_CHECK (function);
+	if (!function)
+		return;
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		result = runtime->startup (module);
+		TEST_CHECK (result);
+		if (!result)
+			return;
+
+		size_t allocSize;
+		result = callConstClosure (runtime, function, &allocSize);
+		TEST_CHECK (result && allocSize);
+
+		result = callConstClosure (runtime, function, &allocSize);
+		TEST_CHECK (result && !allocSize);
+
+		runtime->shutdown ();
+	}
+}
+
+//..............................................................................
+
+// --strip-lib drops library functions nothing refers to: those must report
+// NULL machine code, while everything the program uses must still run
+
+void
+testStripUnusedLibFunctions (const char* fileName)
+{
+	jnc::AutoModule module;
+	jnc::AutoRuntime runtime;
+
+	bool result =
+		compileModule (
+			module,
+			fileName,
+			jnc::ModuleCompileFlag_StdFlags | jnc::ModuleCompileFlag_StripUnusedLibFunctions
+			) &&
+		runtime->startup (module);
+
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	jnc::Function* compareStrings = findFunction (module, "compareStrings");
+	jnc::Function* streq = findFunction (module, "std.streq");
+	jnc::Function* strneq = findFunction (module, "std.strneq");
+	TEST_CHECK (compareStrings && streq && strneq);
+	if (!compareStrings || !streq || !strneq)
+		return;
+
+	TEST_CHECK (compareStrings->getMachineCode ());
+	TEST_CHECK (streq->getMachineCode ());
+	TEST_CHECK (!strneq->getMachineCode ());
+
+	jnc::ModuleCompileStats stats;
+	module->getCompileStats (&stats);
+	TEST_CHECK (stats.m_strippedFunctionCount);
+
+	bool retval = false;
+	result = jnc::callFunction (runtime, compareStrings, &retval);
+	TEST_CHECK (result && retval);
+
+	runtime->shutdown ();
+}
+
+//..............................................................................
+
+// an entered call site keeps the thread attached to the runtime between
+// calls; a failed call must restore the state right after entering, so that
+// both further calls and collections (with the thread parked) keep working
+
+static
+bool
+callEnteredGetElement (
+	jnc::Runtime* runtime,
+	jnc::CallSite* callSite,
+	jnc::Function* function,
+	size_t i,
+	int* retval
+	)
+{
+	bool result = false;
+
+	JNC_BEGIN_ENTERED_CALL_SITE (runtime, callSite)
+		*retval = jnc::callFunctionImpl_u <int> (function->getMachineCode (), i);
+	JNC_END_ENTERED_CALL_SITE_EX (&result)
+
+	return result;
+}
+
+void
+testEnteredCallSite (const char* fileName)
+{
+	jnc::AutoModule module;
+	jnc::AutoRuntime runtime;
+
+	bool result = compileModule (module, fileName) && runtime->startup (module);
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	jnc::Function* getElement = findFunction (module, "getElement");
+	TEST_CHECK (getElement);
+	if (!getElement)
+		return;
+
+	jnc::CallSite callSite;
+	runtime->enterCallSite (&callSite);
+
+	for (size_t i = 0; i < 3; i++)
+	{
+		int retval = 0;
+		result = callEnteredGetElement (runtime, &callSite, getElement, 2, &retval);
+		TEST_CHECK (result && retval == 3);
+
+		// out of range -- the exception is caught by this call alone
+
+		result = callEnteredGetElement (runtime, &callSite, getElement, 4 + i, &retval);
+		TEST_CHECK (!result);
+
+		result = callEnteredGetElement (runtime, &callSite, getElement, 0, &retval);
+		TEST_CHECK (result && retval == 1);
+
+		// the thread is parked between calls, so collecting must not block
+
+		runtime->getGcHeap ()->collect ();
+	}
+
+	runtime->leaveCallSite (&callSite);
+	runtime->shutdown ();
+}
+
+//..............................................................................
+
+// globals, static roots and static destructors of a jitted module live in
+// its image, so a module must not run in two runtimes at the same time
+
+void
+testModuleAttach (const char* fileName)
+{
+	jnc::AutoModule module;
+	jnc::AutoRuntime runtime;
+	jnc::AutoRuntime runtime2;
+
+	bool result = compileModule (module, fileName) && runtime->startup (module);
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	result = runtime2->startup (module);
+	TEST_CHECK (!result);
+
+	// restarting in the same runtime is fine
+
+	result = runtime->startup (module);
+	TEST_CHECK (result);
+
+	// once released, the module can be started in another runtime
+
+	runtime->shutdown ();
+
+	result = runtime2->startup (module);
+	TEST_CHECK (result);
+
+	result = runtime->startup (module);
+	TEST_CHECK (!result);
+
+	runtime2->shutdown ();
+}
+
+//..............................................................................
+
+// units remember the source they were parsed from, so a host watching files
+// can tell whether a change notification actually altered a unit
+
+static
+bool
+writeFile (
+	const char* fileName,
+	const char* source
+	)
+{
+	FILE* file = fopen (fileName, "wb");
+	if (!file)
+		return false;
+
+	fputs (source, file);
+	fclose (file);
+	return true;
+}
+
+void
+testFileModified (const char* fileName)
+{
+	static const char source [] = "int foo () { return 1; }\n";
+
+	sl::String tempFilePath = io::getFullFilePath ("jnc_test_host_modified.jnc");
+	bool result = writeFile (tempFilePath.sz (), source);
+	TEST_CHECK (result);
+	if (!result)
+		return;
+
+	// parse from memory so that no mapping of the file is held (on Windows,
+	// it would prevent rewriting the file below)
+
+	jnc::AutoModule module;
+	module->initialize ("jnc_test_host");
+
+	result =
+		module->parse (tempFilePath.sz (), source) &&
+		module->parseImports () &&
+		module->compile ();
+
+	TEST_CHECK (result);
+
+	if (result)
+	{
+		TEST_CHECK (!module->isFileModified (tempFilePath.sz ()));
+
+		// not a unit of this module -- always reported as modified
+
+		TEST_CHECK (module->isFileModified (fileName));
+
+		// touched, but the contents are the same
+
+		writeFile (tempFilePath.sz (), source);
+		TEST_CHECK (!module->isFileModified (tempFilePath.sz ()));
+
+		// same length, different contents
+
+		writeFile (tempFilePath.sz (), "int foo () { return 2; }\n");
+		TEST_CHECK (module->isFileModified (tempFilePath.sz ()));
+	}
+
+	remove (tempFilePath.sz ());
+}
+
+//..............................................................................
+
+const TestEntry g_testTable [] =
+{
+	{ "stack-size-limit", testStackSizeLimit },
+	{ "closure-identity", testClosureIdentity },
+	{ "closure-cache-restart", testClosureCacheRestart },
+	{ "strip-lib", testStripUnusedLibFunctions },
+	{ "entered-call-site", testEnteredCallSite },
+	{ "module-attach", testModuleAttach },
+	{ "file-modified", testFileModified },
+};
+
+const size_t g_testCount = countof (g_testTable);
+
+//..............................................................................
@@ -0,0 +1,60 @@
+//..............................................................................
+//
+//  This file is part of the Jancy toolkit.
+//
+//  Jancy is distributed under the MIT license.
+//  For details see accompanying license.txt file,
+//  the public copy of which is also available at:
+//  http://tibbo.com/downloads/archive/jancy/license.txt
+//
+//..............................................................................
+
+#pragma once
+
+//..............................................................................
+
+// unlike ASSERT, checks stay in release builds
+
+#define TEST_CHECK(e) \
+	do \
+	{ \
+		if (!(e)) \
+			failTest (#e, __FILE__, __LINE__); \
+	} while (0)
+
+void
+failTest (
+	const char* expression,
+	const char* fileName,
+	int line
+	);
+
+bool
+compileModule (
+	jnc::Module* module,
+	const char* fileName,
+	uint_t compileFlags = jnc::ModuleCompileFlag_StdFlags
+	);
+
+jnc::Function*
+findFunction (
+	jnc::Module* module,
+	const char* name
+	);
+
+//..............................................................................
+
+typedef
+void
+TestFunc (const char* fileName);
+
+struct TestEntry
+{
+	const char* m_name;
+	TestFunc* m_func;
+};
+
+extern const TestEntry g_testTable [];
+extern const size_t g_testCount;
+
+//..............................................................................